@@ -0,0 +1,118 @@
+/* SFE_BMP180 SD card logger example sketch
+
+This sketch logs raw Bosch BMP180 readings to an SD card, 50 times a
+second, without the hiccups you get from writing each reading as it
+arrives.
+https://www.sparkfun.com/products/11824
+
+SD cards sometimes take 100 ms or more to write a sector. Here the
+readings go into one of two blocks in RAM; a full block is written to
+the card in one piece while the next one fills. The sensor keeps
+converting during a write, and if the card ever falls a whole block
+behind, the lost readings are counted instead of stalling the sketch.
+
+The file is in the library's columnar log format, with the sensor's
+calibration in the header. On a computer, BMP180_LogReader and
+BMP180_Batch in the library's extras/host folder read it and turn the
+raw readings into temperature and pressure.
+
+Hardware connections are the same as in the SFE_BMP180_example sketch,
+plus an SD card breakout or shield on the SPI pins (chip select on
+pin 10 here).
+
+Our example code uses the "beerware" license. You can do anything
+you like with this code. No really, anything. If you find it useful,
+buy me a beer someday.
+
+*/
+
+#include <SFE_BMP180.h>
+#include <BMP180_BlockLogger.h>
+#include <BMP180_PrintSink.h>
+#include <SD.h>
+#include <Wire.h>
+
+#define INTERVAL 20 // ms between samples (50 per second)
+#define SD_CS 10 // chip select pin of the SD card
+
+SFE_BMP180 pressure;
+File file;
+BMP180_PrintSink sink(file);
+BMP180_BlockLogger<22> logger(sink); // two blocks of 256 bytes
+
+unsigned long nextSample, nextReport;
+
+void setup()
+{
+  BMP180_Calibration cal;
+
+  Serial.begin(9600);
+  Serial.println("REBOOT");
+
+  if (!pressure.begin())
+  {
+    Serial.println("BMP180 init fail (disconnected?)\n\n");
+    while(1); // Pause forever.
+  }
+
+  if (!SD.begin(SD_CS) || !(file = SD.open("BMP180.LOG", FILE_WRITE)))
+  {
+    Serial.println("SD card fail\n\n");
+    while(1); // Pause forever.
+  }
+
+  // The header stores the calibration, so the log can be turned into
+  // temperature and pressure later. Timestamps are micros().
+
+  pressure.getCalibration(cal);
+  logger.begin(cal, 1);
+
+  // Re-measure temperature every 25 samples (half a second):
+
+  pressure.setTemperatureRefresh(25,0,0.0);
+
+  nextSample = millis();
+  nextReport = nextSample + 10000;
+}
+
+void loop()
+{
+  BMP180_Sample sample;
+  BMP180_LoggerStats stats;
+
+  // Start a new measurement at a steady rate:
+
+  if ((long)(millis() - nextSample) >= 0 && !pressure.busy())
+  {
+    pressure.startCycle(0);
+    nextSample += INTERVAL;
+  }
+
+  // Put each finished sample in the current block. This never waits for the card:
+
+  if (pressure.poll() == BMP180_POLL_READY && pressure.getSample(sample))
+    logger.append(sample);
+
+  // Write full blocks to the card while the sensor converts:
+
+  logger.service();
+
+  // Every 10 seconds, make sure everything so far is on the card and
+  // report how the card is keeping up:
+
+  if ((long)(millis() - nextReport) >= 0)
+  {
+    nextReport += 10000;
+    logger.flush();
+    logger.getStats(stats);
+    Serial.print("samples: ");
+    Serial.print(stats.samples);
+    Serial.print(", dropped: ");
+    Serial.print(stats.dropped);
+    Serial.print(", block writes: ");
+    Serial.print(stats.blocks);
+    Serial.print(", longest write: ");
+    Serial.print(stats.flushMax);
+    Serial.println(" us");
+  }
+}
@@ -0,0 +1,66 @@
+/* SFE_BMP180 measure() example sketch
+
+This sketch shows the shortest way to read the Bosch BMP180 pressure
+sensor: one call to measure() gives you temperature and pressure.
+https://www.sparkfun.com/products/11824
+
+The other examples start each conversion, wait, read the result and
+check for errors step by step. measure() does all of that for you,
+and is a little faster about it: it waits only as long as the sensor
+really needs and uses the I2C bus as little as it can.
+
+Hardware connections are the same as in the SFE_BMP180_example sketch.
+
+Our example code uses the "beerware" license. You can do anything
+you like with this code. No really, anything. If you find it useful,
+buy me a beer someday.
+
+*/
+
+#include <SFE_BMP180.h>
+#include <Wire.h>
+
+SFE_BMP180 pressure;
+
+void setup()
+{
+  Serial.begin(9600);
+  Serial.println("REBOOT");
+
+  if (!pressure.begin())
+  {
+    Serial.println("BMP180 init fail (disconnected?)\n\n");
+    while(1); // Pause forever.
+  }
+
+  // Temperature changes slowly, so only measure it every 10 readings.
+  // Leave this out to measure it every time.
+
+  pressure.setTemperatureRefresh(10,0,0.0);
+}
+
+void loop()
+{
+  BMP180_Sample sample;
+
+  // Take a reading with the highest oversampling setting (3).
+  // This takes about 30 ms.
+
+  sample = pressure.measure(3);
+
+  if (sample.status == 0)
+  {
+    Serial.print("temperature: ");
+    Serial.print(sample.T,2);
+    Serial.print(" deg C, pressure: ");
+    Serial.print(sample.P,2);
+    Serial.println(" mb");
+  }
+  else
+  {
+    Serial.print("error ");
+    Serial.println(sample.status);
+  }
+
+  delay(1000);
+}
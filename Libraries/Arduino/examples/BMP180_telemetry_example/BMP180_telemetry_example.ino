@@ -0,0 +1,61 @@
+/* SFE_BMP180 binary telemetry example sketch
+
+This sketch streams Bosch BMP180 readings to a computer as fast as the
+sensor can make them, in a compact binary format instead of text.
+https://www.sparkfun.com/products/11824
+
+Printing "21.50,987.00" and a timestamp costs about 21 characters per
+reading, so 9600 baud carries fewer than 50 readings a second.
+BMP180_TelemetryWriter packs each reading into 3 to 4 bytes, so the same
+link carries over 200 readings a second, and the CRC on each frame
+catches corrupted data.
+
+The output is not readable in the Serial Monitor. On the computer,
+capture it from the serial port and convert it with the bmp180decode
+tool in the library's extras/host folder:
+
+  bmp180decode capture.bin > readings.csv
+
+Hardware connections are the same as in the SFE_BMP180_example sketch.
+
+Our example code uses the "beerware" license. You can do anything
+you like with this code. No really, anything. If you find it useful,
+buy me a beer someday.
+
+*/
+
+#include <SFE_BMP180.h>
+#include <BMP180_TelemetryWriter.h>
+#include <Wire.h>
+
+SFE_BMP180 pressure;
+BMP180_TelemetryWriter<> telemetry(Serial);
+
+void setup()
+{
+  BMP180_Calibration cal;
+
+  Serial.begin(9600);
+
+  if (!pressure.begin())
+    while(1); // Pause forever.
+
+  // The header carries the sensor's calibration, so the computer can
+  // turn the raw readings into temperature and pressure.
+  // Use BMP180_TELEMETRY_FIXED instead to send finished values.
+
+  pressure.getCalibration(cal);
+  telemetry.begin(cal, BMP180_TELEMETRY_RAW);
+
+  // Temperature changes slowly, so only measure it every 10 readings.
+
+  pressure.setTemperatureRefresh(10,0,0.0);
+}
+
+void loop()
+{
+  // Readings with oversampling setting 0 take about 5 ms; the writer
+  // sends them in frames of about 15 readings.
+
+  telemetry.append(pressure.measure(0));
+}
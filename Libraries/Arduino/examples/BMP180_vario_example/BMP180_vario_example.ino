@@ -0,0 +1,89 @@
+/* SFE_BMP180 variometer example sketch
+
+This sketch shows how to get a smooth altitude and climb rate
+from the Bosch BMP180 pressure sensor.
+https://www.sparkfun.com/products/11824
+
+The altitude example prints single readings, which jump around by
+a meter or so from one to the next. Here the sensor is read 50 times
+a second and every reading goes through SFE_BMP180_AltitudeFilter,
+which averages out the noise and also works out how fast you are
+going up or down.
+
+Hardware connections are the same as in the SFE_BMP180_example sketch.
+
+Our example code uses the "beerware" license. You can do anything
+you like with this code. No really, anything. If you find it useful,
+buy me a beer someday.
+
+*/
+
+#include <SFE_BMP180.h>
+#include <SFE_BMP180_AltitudeFilter.h>
+#include <Wire.h>
+
+#define INTERVAL 20 // ms between samples (50 per second)
+
+SFE_BMP180 pressure;
+SFE_BMP180_AltitudeFilter filter;
+
+unsigned long nextSample, nextPrint;
+
+void setup()
+{
+  double T,P;
+
+  Serial.begin(9600);
+  Serial.println("REBOOT");
+
+  if (!pressure.begin())
+  {
+    Serial.println("BMP180 init fail (disconnected?)\n\n");
+    while(1); // Pause forever.
+  }
+
+  // Use the pressure where we start as the baseline (altitude 0):
+
+  pressure.startCycle(0);
+  while (pressure.poll() == BMP180_POLL_PENDING)
+    ;
+  pressure.getSample(T,P);
+  filter.begin(P,INTERVAL / 1000.0);
+
+  // Re-measure temperature every 25 samples (half a second) instead of every time:
+
+  pressure.setTemperatureRefresh(25,0,0.0);
+
+  nextSample = millis();
+  nextPrint = nextSample;
+}
+
+void loop()
+{
+  double T,P;
+
+  // Start a new measurement at a steady rate; the filter expects evenly spaced samples:
+
+  if ((long)(millis() - nextSample) >= 0 && !pressure.busy())
+  {
+    pressure.startCycle(0);
+    nextSample += INTERVAL;
+  }
+
+  // Feed each finished sample to the filter:
+
+  if (pressure.poll() == BMP180_POLL_READY && pressure.getSample(T,P))
+    filter.update(P);
+
+  // Print twice a second:
+
+  if ((long)(millis() - nextPrint) >= 0)
+  {
+    nextPrint += 500;
+    Serial.print("altitude: ");
+    Serial.print(filter.getAltitude(),2);
+    Serial.print(" m, climb rate: ");
+    Serial.print(filter.getVelocity(),2);
+    Serial.println(" m/s");
+  }
+}
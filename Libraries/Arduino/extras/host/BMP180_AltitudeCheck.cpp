@@ -0,0 +1,131 @@
+/*
+	BMP180_AltitudeCheck.cpp
+	Climb rates from SFE_BMP180_AltitudeFilter, fixed point against floating point
+
+	Built twice by make altitude: with BMP180_ALTITUDE_FLOAT
+	(bmp180altitude) and with BMP180_ALTITUDE_FIXED (bmp180altitude_fixed,
+	the AVR / Cortex-M0 code). Each run feeds the filter 60 s ramps at
+	several climb rates, as integer Pa with noise of about 0.5 m, through
+	updatePressureInt() at 7.5 ms intervals, and prints the mean climb
+	rate over the last 30 s of each. Given the output of the other build,
+	it also checks that the two agree to 0.1%. Last, it checks that a jump
+	from one end of the altitude range to the other is followed rather
+	than wrapping around.
+
+	Usage: bmp180altitude [reference output]
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <SFE_BMP180_AltitudeFilter.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+
+#ifdef BMP180_ALTITUDE_FIXED
+#define MODE_NAME "fixed"
+#else
+#define MODE_NAME "float"
+#endif
+
+#define INTERVAL 0.0075 // seconds, back-to-back OSS 0 cycles
+#define BASELINE 1013.25 // mbar
+#define RAMPS 5
+
+static const double rates[RAMPS] = { 0.3, 5.0, -2.0, 0.0, 0.05 }; // m/s
+
+static uint32_t seed;
+
+static double noise(void)
+// Approximately normal, standard deviation 1: the sum of 12 uniforms, less 6.
+{
+	double sum = 0.0;
+	unsigned char i;
+
+	for (i = 0; i < 12; i++)
+	{
+		seed = (seed * 1664525UL) + 1013904223UL;
+		sum += seed / 4294967296.0;
+	}
+	return(sum - 6.0);
+}
+
+static double ramp(SFE_BMP180_AltitudeFilter &filter, double rate)
+// Feed a 60 s climb at rate from 100 m; returns the mean climb rate of the last 30 s.
+{
+	const unsigned int samples = (unsigned int)(60.0 / INTERVAL);
+	double A, P, sum = 0.0;
+	unsigned int i;
+
+	filter.begin(BASELINE, INTERVAL);
+	for (i = 0; i < samples; i++)
+	{
+		A = 100.0 + (rate * i * INTERVAL) + (0.5 * noise());
+		P = 100.0 * BASELINE * pow(1.0 - (A / 44330.0), 5.255);
+		filter.updatePressureInt((int32_t)floor(P + 0.5));
+		if (i >= samples / 2)
+			sum += filter.getVelocity();
+	}
+	return(sum / (samples - (samples / 2)));
+}
+
+int main(int argc, char *argv[])
+{
+	SFE_BMP180_AltitudeFilter filter;
+	double estimate[RAMPS], reference;
+	FILE *file = NULL;
+	unsigned char i;
+	int failures = 0;
+
+	if ((argc > 1) && ((file = fopen(argv[1], "r")) == NULL))
+	{
+		perror(argv[1]);
+		return(2);
+	}
+
+	for (i = 0; i < RAMPS; i++)
+	{
+		seed = 12345; // the same noise in every run and build
+		estimate[i] = ramp(filter, rates[i]);
+		printf("%s %8.4f m/s: %.6f\n", MODE_NAME, rates[i], estimate[i]);
+		if (fabs(estimate[i] - rates[i]) > 0.01 + (0.01 * fabs(rates[i])))
+		{
+			printf("  FAILED: more than 1%% from the true rate\n");
+			failures++;
+		}
+		if (file)
+		{
+			if (fscanf(file, "%*s %*f m/s: %lf\n", &reference) != 1)
+			{
+				printf("  FAILED: no reference line\n");
+				failures++;
+			}
+			else if (fabs(estimate[i] - reference) > 0.0002 + (0.001 * fabs(reference)))
+			{
+				printf("  FAILED: reference %.6f\n", reference);
+				failures++;
+			}
+		}
+	}
+	if (file)
+		fclose(file);
+
+	// From one end of the range to the other: the error between them does
+	// not fit in 16.16, and must not wrap around to the opposite sign
+
+	filter.begin(BASELINE, INTERVAL);
+	for (i = 0; i < 200; i++)
+		filter.updateAltitude(-30000.0);
+	filter.updateAltitude(30000.0);
+	if (filter.getAltitude() <= -30000.0)
+	{
+		printf("FAILED: jump to +30000 m moved the altitude to %.1f m\n", filter.getAltitude());
+		failures++;
+	}
+
+	if (file)
+		printf(failures ? "FAILED\n" : "passed\n");
+	return(failures ? 1 : 0);
+}
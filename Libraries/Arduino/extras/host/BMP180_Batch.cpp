@@ -0,0 +1,168 @@
+/*
+	BMP180_Batch.cpp
+	Host-side batch compensation of raw BMP180 samples
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <BMP180_Batch.h>
+#include <math.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BMP180_BATCH_X86 1
+#include <immintrin.h>
+#endif
+
+
+void BMP180_computeCoefficients(const BMP180_Calibration &cal, BMP180_Coefficients &coef)
+// Same expressions as SFE_BMP180::begin()
+{
+	double c3,c4,b1;
+
+	c3 = 160.0 * pow(2,-15) * cal.AC3;
+	c4 = pow(10,-3) * pow(2,-15) * cal.AC4;
+	b1 = pow(160,2) * pow(2,-30) * cal.VB1;
+	coef.c5 = (pow(2,-15) / 160) * cal.AC5;
+	coef.c6 = cal.AC6;
+	coef.mc = (pow(2,11) / pow(160,2)) * cal.MC;
+	coef.md = cal.MD / 160.0;
+	coef.x0 = cal.AC1;
+	coef.x1 = 160.0 * pow(2,-13) * cal.AC2;
+	coef.x2 = pow(160,2) * pow(2,-25) * cal.VB2;
+	coef.y0 = c4 * pow(2,15);
+	coef.y1 = c4 * c3;
+	coef.y2 = c4 * b1;
+	coef.p0 = (3791.0 - 8.0) / 1600.0;
+	coef.p1 = 1.0 - 7357.0 * pow(2,-20);
+	coef.p2 = 3038.0 * 100.0 * pow(2,-36);
+}
+
+
+static void compensateScalar(const BMP180_Coefficients &k, const uint16_t *UT, const uint32_t *UP,
+	double *T, double *P, size_t count)
+// One sample at a time; also finishes the tail of the vector kernels.
+// pow(v,2) in the driver is exactly v*v, and UP/256.0 is exactly the
+// driver's (d0 * 256.0) + d1 + (d2/256.0).
+{
+	size_t i;
+	double tu,a,t,pu,s,x,y,z;
+
+	for (i = 0; i < count; i++)
+	{
+		tu = UT[i];
+		a = k.c5 * (tu - k.c6);
+		t = a + (k.mc / (a + k.md));
+
+		pu = UP[i] / 256.0;
+		s = t - 25.0;
+		x = (k.x2 * (s * s)) + (k.x1 * s) + k.x0;
+		y = (k.y2 * (s * s)) + (k.y1 * s) + k.y0;
+		z = (pu - x) / y;
+		T[i] = t;
+		P[i] = (k.p2 * (z * z)) + (k.p1 * z) + k.p0;
+	}
+}
+
+
+#ifdef BMP180_BATCH_X86
+
+__attribute__((target("avx2")))
+static void compensateAVX2(const BMP180_Coefficients &k, const uint16_t *UT, const uint32_t *UP,
+	double *T, double *P, size_t count)
+// Four samples per step. UT and UP both fit in a signed 32-bit lane
+// (UP is at most 24 bits), so the int32 to double conversion is exact.
+{
+	size_t i;
+	const __m256d c5 = _mm256_set1_pd(k.c5), c6 = _mm256_set1_pd(k.c6);
+	const __m256d mc = _mm256_set1_pd(k.mc), md = _mm256_set1_pd(k.md);
+	const __m256d x0 = _mm256_set1_pd(k.x0), x1 = _mm256_set1_pd(k.x1), x2 = _mm256_set1_pd(k.x2);
+	const __m256d y0 = _mm256_set1_pd(k.y0), y1 = _mm256_set1_pd(k.y1), y2 = _mm256_set1_pd(k.y2);
+	const __m256d p0 = _mm256_set1_pd(k.p0), p1 = _mm256_set1_pd(k.p1), p2 = _mm256_set1_pd(k.p2);
+	const __m256d c25 = _mm256_set1_pd(25.0), scale = _mm256_set1_pd(1.0 / 256.0);
+	__m256d tu,a,t,pu,s,ss,x,y,z;
+
+	for (i = 0; i + 4 <= count; i += 4)
+	{
+		tu = _mm256_cvtepi32_pd(_mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)(UT + i))));
+		a = _mm256_mul_pd(c5, _mm256_sub_pd(tu, c6));
+		t = _mm256_add_pd(a, _mm256_div_pd(mc, _mm256_add_pd(a, md)));
+
+		pu = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm_loadu_si128((const __m128i *)(UP + i))), scale);
+		s = _mm256_sub_pd(t, c25);
+		ss = _mm256_mul_pd(s, s);
+		x = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(x2, ss), _mm256_mul_pd(x1, s)), x0);
+		y = _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(y2, ss), _mm256_mul_pd(y1, s)), y0);
+		z = _mm256_div_pd(_mm256_sub_pd(pu, x), y);
+		_mm256_storeu_pd(T + i, t);
+		_mm256_storeu_pd(P + i, _mm256_add_pd(_mm256_add_pd(_mm256_mul_pd(p2, _mm256_mul_pd(z, z)), _mm256_mul_pd(p1, z)), p0));
+	}
+	compensateScalar(k, UT + i, UP + i, T + i, P + i, count - i);
+}
+
+
+__attribute__((target("sse2")))
+static void compensateSSE2(const BMP180_Coefficients &k, const uint16_t *UT, const uint32_t *UP,
+	double *T, double *P, size_t count)
+// Two samples per step, for x86 machines without AVX2.
+{
+	size_t i;
+	const __m128d c5 = _mm_set1_pd(k.c5), c6 = _mm_set1_pd(k.c6);
+	const __m128d mc = _mm_set1_pd(k.mc), md = _mm_set1_pd(k.md);
+	const __m128d x0 = _mm_set1_pd(k.x0), x1 = _mm_set1_pd(k.x1), x2 = _mm_set1_pd(k.x2);
+	const __m128d y0 = _mm_set1_pd(k.y0), y1 = _mm_set1_pd(k.y1), y2 = _mm_set1_pd(k.y2);
+	const __m128d p0 = _mm_set1_pd(k.p0), p1 = _mm_set1_pd(k.p1), p2 = _mm_set1_pd(k.p2);
+	const __m128d c25 = _mm_set1_pd(25.0), scale = _mm_set1_pd(1.0 / 256.0);
+	__m128d tu,a,t,pu,s,ss,x,y,z;
+
+	for (i = 0; i + 2 <= count; i += 2)
+	{
+		tu = _mm_set_pd(UT[i+1], UT[i]);
+		a = _mm_mul_pd(c5, _mm_sub_pd(tu, c6));
+		t = _mm_add_pd(a, _mm_div_pd(mc, _mm_add_pd(a, md)));
+
+		pu = _mm_mul_pd(_mm_set_pd(UP[i+1], UP[i]), scale);
+		s = _mm_sub_pd(t, c25);
+		ss = _mm_mul_pd(s, s);
+		x = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x2, ss), _mm_mul_pd(x1, s)), x0);
+		y = _mm_add_pd(_mm_add_pd(_mm_mul_pd(y2, ss), _mm_mul_pd(y1, s)), y0);
+		z = _mm_div_pd(_mm_sub_pd(pu, x), y);
+		_mm_storeu_pd(T + i, t);
+		_mm_storeu_pd(P + i, _mm_add_pd(_mm_add_pd(_mm_mul_pd(p2, _mm_mul_pd(z, z)), _mm_mul_pd(p1, z)), p0));
+	}
+	compensateScalar(k, UT + i, UP + i, T + i, P + i, count - i);
+}
+
+#endif
+
+
+void BMP180_compensateBatch(const BMP180_Coefficients &coef, const uint16_t *UT, const uint32_t *UP,
+	double *T, double *P, size_t count)
+{
+#ifdef BMP180_BATCH_X86
+	if (__builtin_cpu_supports("avx2"))
+	{
+		compensateAVX2(coef, UT, UP, T, P, count);
+		return;
+	}
+	if (__builtin_cpu_supports("sse2"))
+	{
+		compensateSSE2(coef, UT, UP, T, P, count);
+		return;
+	}
+#endif
+	compensateScalar(coef, UT, UP, T, P, count);
+}
+
+
+const char *BMP180_batchKernel(void)
+{
+#ifdef BMP180_BATCH_X86
+	if (__builtin_cpu_supports("avx2"))
+		return("avx2");
+	if (__builtin_cpu_supports("sse2"))
+		return("sse2");
+#endif
+	return("scalar");
+}
@@ -0,0 +1,48 @@
+/*
+	BMP180_Batch.h
+	Host-side batch compensation of raw BMP180 samples
+
+	Runs the same floating-point equations as SFE_BMP180::getTemperature() and
+	getPressure() over whole arrays of raw readings, for servers that receive
+	raw UT/UP counts plus each device's calibration.
+
+	On x86 the kernel is picked at run time: AVX2 (4 samples per step), SSE2
+	(2 per step), or a portable scalar loop elsewhere. Every path performs the
+	driver's operations in the driver's order, so results are bit-for-bit
+	identical to SFE_BMP180 built for the same host, as long as neither is
+	compiled with floating-point contraction (build with -ffp-contract=off;
+	with FMA contraction allowed the difference stays within a few ulp).
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_Batch_h
+#define BMP180_Batch_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <BMP180_Calibration.h>
+
+struct BMP180_Coefficients
+{
+	double c5,c6,mc,md,x0,x1,x2,y0,y1,y2,p0,p1,p2;
+};
+
+void BMP180_computeCoefficients(const BMP180_Calibration &cal, BMP180_Coefficients &coef);
+	// derive the floating-point polynomials from one device's calibration words
+	// (the same values SFE_BMP180::begin() computes)
+
+void BMP180_compensateBatch(const BMP180_Coefficients &coef, const uint16_t *UT, const uint32_t *UP,
+	double *T, double *P, size_t count);
+	// compensate count raw samples from one device (structure-of-arrays)
+	// UT: raw temperature words (0xF6-0xF7)
+	// UP: raw 24-bit pressure readings (0xF6-0xF8, any oversampling setting)
+	// T: output temperatures (deg C)
+	// P: output absolute pressures (mbar)
+
+const char *BMP180_batchKernel(void);
+	// name of the kernel BMP180_compensateBatch() uses on this machine ("avx2", "sse2" or "scalar")
+
+#endif
@@ -0,0 +1,441 @@
+/*
+	BMP180_Benchmark.cpp
+	Benchmark of the driver's compute and bus paths on the simulated bus
+
+	Runs SFE_BMP180 (BMP180_Driver<TwoWire>, the same driver Teensy_BMP180
+	uses) against the BMP180_Model in sim/ and prints one JSON object on stdout:
+
+	- "compute": host nanoseconds per call for begin() (also with the
+	  calibration cached in a store), getTemperature(),
+	  getPressure() in float and integer compensation, altitude() and
+	  sealevel() (SFE_BMP180 and SFE_BMP180_Altimeter). Calls that read the
+	  sensor include the simulated I2C transfer; "bus_read_2" and
+	  "bus_read_3" time the same transfers alone so the compensation part
+	  can be told apart.
+
+	- "bus": per complete sample (temperature + pressure) at 100 kHz and
+	  400 kHz: I2C transactions, bytes on the wire, STOP conditions,
+	  simulated bus time and simulated end-to-end time, for the blocking
+	  calls, the non-blocking cycle with and without SCO polling, blocking
+	  at OSS 3, and measure() (also with the temperature reused for 10
+	  samples).
+
+	- "telemetry": bytes per sample sent over a serial port, and the
+	  samples per second that fit through 9600 and 115200 baud, for a
+	  CSV text line (time,T,P as a sketch would print them) and for
+	  BMP180_TelemetryWriter<> in raw and fixed-point mode. Uses
+	  measure(0) with the sensor's pressure noise switched on.
+
+	Usage: bmp180bench [iterations]   (default 200000)
+
+	POSIX only (clock_gettime). Our example code uses the "beerware"
+	license. You can do anything you like with this code. No really,
+	anything. If you find it useful, buy me a (root) beer someday.
+*/
+
+#include <SFE_BMP180.h>
+#include <SFE_BMP180_Altimeter.h>
+#include <BMP180_Model.h>
+#include <BMP180_TelemetryWriter.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_SAMPLES 200 // complete samples per bus measurement
+#define TELEMETRY_SAMPLES 2000 // samples per telemetry measurement
+
+static BMP180_Model sensor;
+static volatile double sink; // keeps results alive
+static unsigned long iterations = 200000;
+static char firstEntry;
+
+
+class MemoryStore : public BMP180_CalibrationStore
+	// calibration store in RAM, for timing begin() with a warm cache
+{
+	public:
+		MemoryStore() : length(0) {}
+
+		char load(void *data, unsigned int n)
+		{
+			if (n != length)
+				return(0);
+			memcpy(data, buffer, n);
+			return(1);
+		}
+
+		char save(const void *data, unsigned int n)
+		{
+			if (n > sizeof(buffer))
+				return(0);
+			memcpy(buffer, data, n);
+			length = n;
+			return(1);
+		}
+
+	private:
+		uint8_t buffer[256];
+		unsigned int length;
+};
+
+
+class CountingPrint : public Print
+	// output that only counts the bytes written to it
+{
+	public:
+		CountingPrint() : bytes(0) {}
+
+		size_t write(uint8_t b)
+		{
+			bytes++;
+			return(1);
+		}
+
+		size_t write(const uint8_t *buffer, size_t size)
+		{
+			bytes += size;
+			return(size);
+		}
+
+		unsigned long bytes;
+};
+
+
+static double now(void)
+// Host time in nanoseconds
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return((ts.tv_sec * 1e9) + ts.tv_nsec);
+}
+
+
+static void entry(const char *name, double ns)
+{
+	printf("%s\n    \"%s\": %.1f", firstEntry ? "" : ",", name, ns);
+	firstEntry = 0;
+}
+
+
+// Compute paths ---------------------------------------------------------
+
+static void benchCompute(void)
+{
+	SFE_BMP180 pressure, cached;
+	MemoryStore store;
+	SFE_BMP180_Altimeter altimeter;
+	unsigned long i, n;
+	double t0, T, P;
+	int16_t Ti;
+	int32_t Pi = 0;
+	uint8_t buffer[3];
+
+	Wire.setClock(400000);
+	printf("  \"compute\": {");
+	firstEntry = 1;
+
+	// begin() is dominated by the calibration read; fewer runs are plenty
+	n = (iterations / 10) + 1;
+	t0 = now();
+	for (i = 0; i < n; i++)
+		sink = pressure.begin();
+	entry("begin", (now() - t0) / n);
+
+	cached.setCalibrationStore(&store);
+	cached.begin(); // fills the store
+	t0 = now();
+	for (i = 0; i < n; i++)
+		sink = cached.begin();
+	entry("begin_cached", (now() - t0) / n);
+
+	// the bare transfers inside getTemperature() / getPressure()
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+	{
+		buffer[0] = 0xF6;
+		Wire.beginTransmission(0x77);
+		Wire.write(buffer[0]);
+		Wire.endTransmission();
+		Wire.requestFrom(0x77, 2);
+		buffer[0] = Wire.read();
+		buffer[1] = Wire.read();
+		sink = buffer[0] + buffer[1];
+	}
+	entry("bus_read_2", (now() - t0) / iterations);
+
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+	{
+		Wire.beginTransmission(0x77);
+		Wire.write(0xF6);
+		Wire.endTransmission();
+		Wire.requestFrom(0x77, 3);
+		buffer[0] = Wire.read();
+		buffer[1] = Wire.read();
+		buffer[2] = Wire.read();
+		sink = buffer[0] + buffer[1] + buffer[2];
+	}
+	entry("bus_read_3", (now() - t0) / iterations);
+
+	// each get re-reads the finished conversion, so no waits are timed
+	delay(pressure.startTemperature());
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+	{
+		pressure.getTemperature(T);
+		sink = T;
+	}
+	entry("getTemperature_float", (now() - t0) / iterations);
+
+	pressure.setCompensation(BMP180_COMPENSATION_INTEGER);
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+	{
+		pressure.getTemperatureInt(Ti);
+		sink = Ti;
+	}
+	entry("getTemperature_integer", (now() - t0) / iterations);
+	pressure.setCompensation(BMP180_COMPENSATION_FLOAT);
+
+	delay(pressure.startPressure(3));
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+	{
+		pressure.getPressure(P,T);
+		sink = P;
+	}
+	entry("getPressure_float", (now() - t0) / iterations);
+
+	pressure.setCompensation(BMP180_COMPENSATION_INTEGER);
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+	{
+		pressure.getPressureInt(Pi);
+		sink = Pi;
+	}
+	entry("getPressure_integer", (now() - t0) / iterations);
+	pressure.setCompensation(BMP180_COMPENSATION_FLOAT);
+
+	// pure math; vary the input so nothing is hoisted out of the loop
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+		sink = pressure.altitude(900.0 + (i & 127), 1013.25);
+	entry("altitude", (now() - t0) / iterations);
+
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+		sink = altimeter.altitude(900.0 + (i & 127));
+	entry("altitude_table", (now() - t0) / iterations);
+
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+		sink = pressure.sealevel(900.0 + (i & 127), 1655.0);
+	entry("sealevel", (now() - t0) / iterations);
+
+	t0 = now();
+	for (i = 0; i < iterations; i++)
+		sink = altimeter.sealevel(900.0 + (i & 127), 1655.0);
+	entry("sealevel_cached", (now() - t0) / iterations);
+
+	printf("\n  }");
+}
+
+
+// Bus paths -------------------------------------------------------------
+
+struct BusCounts
+{
+	unsigned long transactions, bytes, stops;
+	uint64_t busMicros, start;
+};
+
+
+static void busStart(BusCounts &c)
+{
+	c.transactions = Wire.transactions;
+	c.bytes = Wire.bytes;
+	c.stops = Wire.stops;
+	c.busMicros = Wire.busMicros;
+	c.start = simMicros();
+}
+
+
+static void busEntry(const char *name, const BusCounts &c)
+{
+	printf("%s\n      \"%s\": { \"transactions\": %.2f, \"bytes\": %.2f, \"stops\": %.2f, \"bus_us\": %.1f, \"sample_us\": %.1f }",
+		firstEntry ? "" : ",", name,
+		(double)(Wire.transactions - c.transactions) / BENCH_SAMPLES,
+		(double)(Wire.bytes - c.bytes) / BENCH_SAMPLES,
+		(double)(Wire.stops - c.stops) / BENCH_SAMPLES,
+		(double)(Wire.busMicros - c.busMicros) / BENCH_SAMPLES,
+		(double)(simMicros() - c.start) / BENCH_SAMPLES);
+	firstEntry = 0;
+}
+
+
+static void benchBus(uint32_t clock)
+{
+	SFE_BMP180 pressure, cached;
+	MemoryStore store;
+	BusCounts c;
+	unsigned int i;
+	double T, P;
+
+	Wire.setClock(clock);
+	printf("    \"%lu\": {", (unsigned long)clock);
+	firstEntry = 1;
+
+	busStart(c);
+	pressure.begin();
+	printf("\n      \"begin\": { \"transactions\": %lu, \"bytes\": %lu, \"bus_us\": %lu }",
+		Wire.transactions - c.transactions, Wire.bytes - c.bytes,
+		(unsigned long)(Wire.busMicros - c.busMicros));
+	firstEntry = 0;
+
+	cached.setCalibrationStore(&store);
+	cached.begin(); // fills the store
+	busStart(c);
+	cached.begin();
+	printf(",\n      \"begin_cached\": { \"transactions\": %lu, \"bytes\": %lu, \"bus_us\": %lu }",
+		Wire.transactions - c.transactions, Wire.bytes - c.bytes,
+		(unsigned long)(Wire.busMicros - c.busMicros));
+
+	busStart(c);
+	for (i = 0; i < BENCH_SAMPLES; i++)
+	{
+		delay(pressure.startTemperature());
+		pressure.getTemperature(T);
+		delay(pressure.startPressure(0));
+		pressure.getPressure(P,T);
+	}
+	busEntry("blocking_oss0", c);
+
+	busStart(c);
+	for (i = 0; i < BENCH_SAMPLES; i++)
+	{
+		pressure.startCycle(0);
+		while (pressure.poll() == BMP180_POLL_PENDING)
+			delayMicroseconds(100);
+		pressure.getSample(T,P);
+	}
+	busEntry("cycle_oss0", c);
+
+	pressure.setConversionPolling(500,40);
+	busStart(c);
+	for (i = 0; i < BENCH_SAMPLES; i++)
+	{
+		pressure.startCycle(0);
+		while (pressure.poll() == BMP180_POLL_PENDING)
+			delayMicroseconds(100);
+		pressure.getSample(T,P);
+	}
+	busEntry("cycle_oss0_sco", c);
+	pressure.setConversionPolling(0,0);
+
+	busStart(c);
+	for (i = 0; i < BENCH_SAMPLES; i++)
+	{
+		delay(pressure.startTemperature());
+		pressure.getTemperature(T);
+		delay(pressure.startPressure());
+		pressure.getPressure(P,T);
+	}
+	busEntry("blocking_oss3", c);
+
+	busStart(c);
+	for (i = 0; i < BENCH_SAMPLES; i++)
+		pressure.measure(0);
+	busEntry("measure_oss0", c);
+
+	busStart(c);
+	for (i = 0; i < BENCH_SAMPLES; i++)
+		pressure.measure(3);
+	busEntry("measure_oss3", c);
+
+	pressure.setTemperatureRefresh(10,0,0.0);
+	busStart(c);
+	for (i = 0; i < BENCH_SAMPLES; i++)
+		pressure.measure(0);
+	busEntry("measure_oss0_refresh10", c);
+	pressure.setTemperatureRefresh(0,0,0.0);
+
+	printf("\n    }");
+}
+
+
+// Serial telemetry -----------------------------------------------------
+
+static void telemetryEntry(const char *name, unsigned long bytes)
+{
+	double perSample = (double)bytes / TELEMETRY_SAMPLES;
+
+	printf("%s\n    \"%s\": { \"bytes_per_sample\": %.2f, \"samples_per_s_9600\": %.1f, \"samples_per_s_115200\": %.1f }",
+		firstEntry ? "" : ",", name, perSample, 960.0 / perSample, 11520.0 / perSample);
+	firstEntry = 0;
+}
+
+
+static void benchTelemetry(void)
+{
+	SFE_BMP180 pressure;
+	BMP180_Calibration cal;
+	BMP180_Sample s;
+	CountingPrint out;
+	char line[64];
+	unsigned int i;
+
+	Wire.setClock(400000);
+	sensor.setNoise(1);
+	pressure.begin();
+	pressure.getCalibration(cal);
+	printf("  \"telemetry\": {");
+	firstEntry = 1;
+
+	out.bytes = 0;
+	for (i = 0; i < TELEMETRY_SAMPLES; i++)
+	{
+		s = pressure.measure(0);
+		out.bytes += snprintf(line, sizeof(line), "%lu,%.2f,%.2f\r\n", (unsigned long)millis(), s.T, s.P);
+	}
+	telemetryEntry("text_csv", out.bytes);
+
+	for (char mode = BMP180_TELEMETRY_RAW; mode <= BMP180_TELEMETRY_FIXED; mode++)
+	{
+		BMP180_TelemetryWriter<> telemetry(out);
+
+		out.bytes = 0;
+		telemetry.begin(cal, mode);
+		for (i = 0; i < TELEMETRY_SAMPLES; i++)
+			telemetry.append(pressure.measure(0));
+		telemetry.flush();
+		telemetryEntry((mode == BMP180_TELEMETRY_RAW) ? "binary_raw" : "binary_fixed", out.bytes);
+	}
+
+	printf("\n  }");
+	sensor.setNoise(0);
+}
+
+
+int main(int argc, char **argv)
+{
+	if (argc > 1)
+		iterations = strtoul(argv[1], 0, 10);
+	if (iterations == 0)
+		iterations = 1;
+
+	Wire.attach(sensor);
+	sensor.setConditions(21.5, 987.0);
+
+	printf("{\n  \"iterations\": %lu,\n", iterations);
+	benchCompute();
+	printf(",\n  \"bus\": {\n");
+	benchBus(100000);
+	printf(",\n");
+	benchBus(400000);
+	printf("\n  },\n");
+	benchTelemetry();
+	printf("\n}\n");
+	return(0);
+}
@@ -0,0 +1,57 @@
+/*
+	BMP180_Decode.cpp
+	Command-line decoder for the BMP180 binary telemetry stream
+
+	Reads a stream written by BMP180_TelemetryWriter (a capture file, or
+	a serial port set to raw mode) and prints one CSV line per sample:
+
+	  time_us,T,P,UT,UP,oss
+
+	T is in deg C and P in mbar; the raw columns are 0 for streams in
+	fixed-point mode. Frame and error counts go to stderr at the end.
+
+	Usage: bmp180decode [file]   (default: standard input)
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <BMP180_TelemetryDecoder.h>
+#include <stdio.h>
+
+int main(int argc, char **argv)
+{
+	BMP180_TelemetryDecoder decoder;
+	BMP180_TelemetrySample s;
+	uint8_t buffer[4096];
+	const uint8_t *p;
+	size_t n, used;
+	FILE *in = stdin;
+
+	if (argc > 1 && !(in = fopen(argv[1], "rb")))
+	{
+		perror(argv[1]);
+		return(1);
+	}
+
+	printf("time_us,T,P,UT,UP,oss\n");
+	while ((n = fread(buffer, 1, sizeof(buffer), in)) > 0)
+		for (p = buffer; n > 0; )
+		{
+			used = decoder.feed(p, n);
+			p += used;
+			n -= used;
+			while (decoder.next(s))
+				printf("%lu,%.2f,%.2f,%u,%lu,%u\n", (unsigned long)s.time, s.T, s.P,
+					s.UT, (unsigned long)s.UP, s.oss);
+		}
+
+	const BMP180_TelemetryStats &stats = decoder.stats();
+	fprintf(stderr, "%llu samples, %lu frames, %lu bad, %lu lost, %llu bytes skipped\n",
+		(unsigned long long)stats.samples, (unsigned long)stats.frames, (unsigned long)stats.badFrames,
+		(unsigned long)stats.lostFrames, (unsigned long long)stats.skippedBytes);
+	if (in != stdin)
+		fclose(in);
+	return(0);
+}
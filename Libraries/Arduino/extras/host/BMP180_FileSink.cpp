@@ -0,0 +1,72 @@
+/*
+	BMP180_FileSink.cpp
+	Log sink that writes to a file
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <BMP180_FileSink.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+BMP180_FileSink::BMP180_FileSink()
+{
+	fd = -1;
+}
+
+
+BMP180_FileSink::~BMP180_FileSink()
+{
+	close();
+}
+
+
+bool BMP180_FileSink::open(const char *path)
+{
+	close();
+	fd = ::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	return(fd >= 0);
+}
+
+
+void BMP180_FileSink::close(void)
+{
+	if (fd >= 0)
+		::close(fd);
+	fd = -1;
+}
+
+
+char BMP180_FileSink::write(const void *data, unsigned int length)
+// Keep writing until the whole block is in; write() may take part of it,
+// or be interrupted by a signal.
+{
+	const char *p = (const char *)data;
+	ssize_t n;
+
+	if (fd < 0)
+		return(0);
+	while (length > 0)
+	{
+		n = ::write(fd, p, length);
+		if (n < 0 && errno == EINTR)
+			continue;
+		if (n <= 0)
+			return(0);
+		p += n;
+		length -= n;
+	}
+	return(1);
+}
+
+
+char BMP180_FileSink::sync(void)
+{
+	if (fd < 0)
+		return(0);
+	return(fsync(fd) == 0);
+}
@@ -0,0 +1,53 @@
+/*
+	BMP180_FileSink.h
+	Log sink that writes to a file, for running BMP180_BlockLogger on a
+	desktop (host simulation, or a Linux board with the sensor on its I2C bus)
+
+		BMP180_FileSink sink;
+		if (sink.open("flight.bmp"))
+		{
+			BMP180_BlockLogger<45> logger(sink);
+			...
+		}
+
+	The file is created or truncated by open(). sync() calls fsync(),
+	so the data is on the disk when flush() returns; write() leaves that
+	to the operating system.
+
+	POSIX only. Our example code uses the "beerware" license. You can do
+	anything you like with this code. No really, anything. If you find it
+	useful, buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_FileSink_h
+#define BMP180_FileSink_h
+
+#include <BMP180_LogSink.h>
+
+class BMP180_FileSink : public BMP180_LogSink
+{
+	public:
+		BMP180_FileSink();
+		~BMP180_FileSink();
+
+		bool open(const char *path);
+			// create (or empty) the file at path
+			// returns true for success, false if it cannot be created
+
+		void close(void);
+			// close the file (also done by the destructor)
+
+		char write(const void *data, unsigned int length);
+			// returns 0 if no file is open or the write failed
+
+		char sync(void);
+			// returns 0 if no file is open or the sync failed
+
+	private:
+		BMP180_FileSink(const BMP180_FileSink &);
+		BMP180_FileSink &operator=(const BMP180_FileSink &);
+
+		int fd;
+};
+
+#endif
@@ -0,0 +1,55 @@
+/*
+	BMP180_FileStore.cpp
+	Calibration store in a file
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <BMP180_FileStore.h>
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+
+BMP180_FileStore::BMP180_FileStore(const char *path)
+{
+	this->path = path;
+}
+
+
+char BMP180_FileStore::load(void *data, unsigned int length)
+{
+	int fd;
+	ssize_t n;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return(0);
+	n = read(fd, data, length);
+	close(fd);
+	return(n == (ssize_t)length);
+}
+
+
+char BMP180_FileStore::save(const void *data, unsigned int length)
+// Write path.tmp, then rename it over path.
+{
+	char tmp[1024];
+	int fd;
+	ssize_t n;
+
+	if (snprintf(tmp, sizeof(tmp), "%s.tmp", path) >= (int)sizeof(tmp))
+		return(0);
+	fd = open(tmp, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	if (fd < 0)
+		return(0);
+	n = write(fd, data, length);
+	if ((close(fd) != 0) || (n != (ssize_t)length) || (rename(tmp, path) != 0))
+	{
+		unlink(tmp);
+		return(0);
+	}
+	return(1);
+}
@@ -0,0 +1,38 @@
+/*
+	BMP180_FileStore.h
+	Calibration store in a file, for running the driver on a desktop
+	(host simulation, or a Linux board with the sensor on its I2C bus)
+
+		BMP180_FileStore store("bmp180.cal");
+		pressure.setCalibrationStore(&store);
+		pressure.begin();
+
+	save() writes a temporary file and renames it over the old one, so a
+	crash part way through leaves the previous record intact.
+
+	POSIX only. Our example code uses the "beerware" license. You can do
+	anything you like with this code. No really, anything. If you find it
+	useful, buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_FileStore_h
+#define BMP180_FileStore_h
+
+#include <BMP180_CalibrationStore.h>
+
+class BMP180_FileStore : public BMP180_CalibrationStore
+{
+	public:
+		BMP180_FileStore(const char *path);
+			// path: file to keep the record in (the string must outlive the store)
+
+		char load(void *data, unsigned int length);
+			// returns 0 if the file is missing or shorter than length
+
+		char save(const void *data, unsigned int length);
+
+	private:
+		const char *path;
+};
+
+#endif
@@ -0,0 +1,131 @@
+/*
+	BMP180_LogReader.cpp
+	Memory-mapped reader for the columnar BMP180 log format
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <BMP180_LogReader.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+
+BMP180_LogReader::BMP180_LogReader()
+{
+	map = NULL;
+	mapBytes = 0;
+	blockBytes = 0;
+	blockCount = 0;
+}
+
+
+BMP180_LogReader::~BMP180_LogReader()
+{
+	close();
+}
+
+
+bool BMP180_LogReader::open(const char *path)
+{
+	int fd;
+	struct stat st;
+	void *p;
+	const BMP180_LogHeader *h;
+
+	close();
+
+	fd = ::open(path, O_RDONLY);
+	if (fd < 0)
+		return(false);
+	if ((fstat(fd, &st) != 0) || (st.st_size < BMP180_LOG_HEADER_BYTES))
+	{
+		::close(fd);
+		return(false);
+	}
+	p = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd); // the mapping stays valid without the descriptor
+	if (p == MAP_FAILED)
+		return(false);
+
+	map = (const uint8_t *)p;
+	mapBytes = st.st_size;
+
+	h = (const BMP180_LogHeader *)map;
+	if ((memcmp(h->magic, BMP180_LOG_MAGIC, sizeof(h->magic)) != 0) ||
+		(h->version != BMP180_LOG_VERSION) ||
+		(h->blockSamples == 0))
+	{
+		close();
+		return(false);
+	}
+	madvise(p, mapBytes, MADV_SEQUENTIAL);
+
+	blockBytes = BMP180_logBlockBytes(h->blockSamples);
+	blockCount = (mapBytes - BMP180_LOG_HEADER_BYTES) / blockBytes;
+	return(true);
+}
+
+
+void BMP180_LogReader::close(void)
+{
+	if (map != NULL)
+		munmap((void *)map, mapBytes);
+	map = NULL;
+	mapBytes = 0;
+	blockBytes = 0;
+	blockCount = 0;
+}
+
+
+const BMP180_LogHeader &BMP180_LogReader::header(void) const
+{
+	return(*(const BMP180_LogHeader *)map);
+}
+
+
+uint32_t BMP180_LogReader::blocks(void) const
+{
+	return(blockCount);
+}
+
+
+uint64_t BMP180_LogReader::samples(void) const
+{
+	uint64_t total = 0;
+	BMP180_LogBlock b;
+	uint32_t n;
+
+	for (n = 0; n < blockCount; n++)
+		if (block(n, b))
+			total += b.count;
+	return(total);
+}
+
+
+bool BMP180_LogReader::block(uint32_t n, BMP180_LogBlock &b) const
+{
+	const uint8_t *base;
+	const BMP180_LogBlockHeader *bh;
+	uint32_t samples;
+
+	if (n >= blockCount)
+		return(false);
+	samples = header().blockSamples;
+	base = map + BMP180_LOG_HEADER_BYTES + (size_t)n * blockBytes;
+	bh = (const BMP180_LogBlockHeader *)base;
+	if ((bh->magic != BMP180_LOG_BLOCK_MAGIC) || (bh->count == 0) || (bh->count > samples))
+		return(false);
+
+	base += sizeof(BMP180_LogBlockHeader);
+	b.count = bh->count;
+	b.time = (const uint32_t *)base;
+	b.UP = (const uint32_t *)(base + samples * 4);
+	b.UT = (const uint16_t *)(base + samples * 8);
+	b.oss = base + samples * 10;
+	return(true);
+}
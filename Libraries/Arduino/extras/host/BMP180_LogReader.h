@@ -0,0 +1,75 @@
+/*
+	BMP180_LogReader.h
+	Memory-mapped reader for the columnar BMP180 log format (see BMP180_LogFormat.h)
+
+	The file is mapped read-only and every column is handed out as a
+	pointer into the mapping, so iterating a log copies and parses nothing:
+
+		BMP180_LogReader log;
+		if (log.open("flight.bmp"))
+		{
+			BMP180_LogBlock b;
+			for (uint32_t n = 0; n < log.blocks(); n++)
+				if (log.block(n, b))
+					for (uint32_t i = 0; i < b.count; i++)
+						use(b.time[i], b.UT[i], b.UP[i], b.oss[i]);
+		}
+
+	POSIX only (mmap). Our example code uses the "beerware" license.
+	You can do anything you like with this code. No really, anything.
+	If you find it useful, buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_LogReader_h
+#define BMP180_LogReader_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <BMP180_LogFormat.h>
+
+struct BMP180_LogBlock
+{
+	uint32_t count; // samples in this block
+	const uint32_t *time;
+	const uint32_t *UP;
+	const uint16_t *UT;
+	const uint8_t *oss;
+};
+
+class BMP180_LogReader
+{
+	public:
+		BMP180_LogReader();
+		~BMP180_LogReader();
+
+		bool open(const char *path);
+			// map a log file and check its header
+			// returns true for success, false if the file is missing or not a version 1 log
+
+		void close(void);
+			// unmap the file (also done by the destructor)
+
+		const BMP180_LogHeader &header(void) const;
+			// file header, including the sensor calibration
+
+		uint32_t blocks(void) const;
+			// number of complete blocks in the file (a torn final block is ignored)
+
+		uint64_t samples(void) const;
+			// total number of samples in all blocks
+
+		bool block(uint32_t n, BMP180_LogBlock &b) const;
+			// point b at the columns of block n
+			// returns false if n is out of range or the block header is damaged
+
+	private:
+		BMP180_LogReader(const BMP180_LogReader &);
+		BMP180_LogReader &operator=(const BMP180_LogReader &);
+
+		const uint8_t *map;
+		size_t mapBytes;
+		uint32_t blockBytes;
+		uint32_t blockCount;
+};
+
+#endif
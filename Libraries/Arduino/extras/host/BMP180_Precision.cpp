@@ -0,0 +1,79 @@
+/*
+	BMP180_Precision.cpp
+	Accuracy of single-precision (float) compensation against double
+
+	Runs BMP180_Driver<TwoWire,float> and BMP180_Driver<TwoWire,double>
+	on the same simulated sensor over its whole operating range, every
+	1 deg C from -40 to 85 deg C and every 1 mbar from 300 to 1100 mbar,
+	and prints the largest and rms differences in temperature and
+	pressure for each oversampling setting. Both drivers see the same raw
+	readings, so the differences are rounding alone.
+
+	Usage: bmp180precision
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <BMP180_Driver.h>
+#include <BMP180_Model.h>
+#include <Wire.h>
+#include <math.h>
+#include <stdio.h>
+
+int main(void)
+{
+	BMP180_Model sensor;
+	BMP180_Driver<TwoWire,float> single(&Wire);
+	BMP180_Driver<TwoWire,double> full(&Wire);
+	BMP180_Sample s, d;
+	double T, P, dT, dP, maxT, maxP, sumP, atT, atP;
+	unsigned long n, mismatched;
+	char oss;
+
+	Wire.attach(sensor);
+	Wire.setClock(400000);
+	if (!single.begin() || !full.begin())
+	{
+		printf("begin() failed\n");
+		return(1);
+	}
+
+	printf("float - double, -40 to 85 deg C x 300 to 1100 mbar\n");
+	for (oss = 0; oss <= 3; oss++)
+	{
+		maxT = maxP = sumP = atT = atP = 0.0;
+		n = mismatched = 0;
+		for (T = -40.0; T <= 85.0; T += 1.0)
+			for (P = 300.0; P <= 1100.0; P += 1.0)
+			{
+				sensor.setConditions(T, P);
+				s = single.measure(oss);
+				d = full.measure(oss);
+				if (s.status || d.status || (s.UT != d.UT) || (s.UP != d.UP))
+				{
+					mismatched++;
+					continue;
+				}
+				dT = fabs(s.T - d.T);
+				dP = fabs(s.P - d.P);
+				if (dT > maxT)
+					maxT = dT;
+				if (dP > maxP)
+				{
+					maxP = dP;
+					atT = T;
+					atP = P;
+				}
+				sumP += dP * dP;
+				n++;
+			}
+		printf("OSS %d: %lu points, temperature max %.6f deg C, pressure max %.6f mbar (at %.0f deg C, %.0f mbar), rms %.6f mbar",
+			oss, n, maxT, maxP, atT, atP, n ? sqrt(sumP / n) : 0.0);
+		if (mismatched)
+			printf(", %lu points skipped", mismatched);
+		printf("\n");
+	}
+	return(0);
+}
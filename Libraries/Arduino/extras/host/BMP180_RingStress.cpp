@@ -0,0 +1,94 @@
+/*
+	BMP180_RingStress.cpp
+	Producer/consumer stress test of BMP180_RingBuffer
+
+	Runs push() and pop() on two threads, as a sampling task and loop()
+	would on a dual-core board, and checks that every item arrives once,
+	in order and whole. Each item is a sequence number plus words derived
+	from it, so an item read before the producer finished writing it (a
+	missing barrier) shows up as a mismatch. Tries the smallest buffer,
+	where the two sides collide on nearly every call, and a larger one.
+
+	Usage: bmp180stress [items per run]
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <BMP180_RingBuffer.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <thread>
+
+struct StressItem
+{
+	uint32_t sequence;
+	uint32_t check[3]; // functions of sequence, to spot a torn copy
+};
+
+static void fill(StressItem &item, uint32_t sequence)
+{
+	item.sequence = sequence;
+	item.check[0] = ~sequence;
+	item.check[1] = sequence * 2654435761UL;
+	item.check[2] = sequence ^ 0xA5A5A5A5UL;
+}
+
+template <unsigned int CAPACITY>
+static unsigned long run(uint32_t items)
+// Pass items through a CAPACITY buffer; returns the number of bad items.
+{
+	static BMP180_RingBuffer<StressItem,CAPACITY> ring;
+	StressItem item, expected;
+	unsigned long bad = 0;
+	uint32_t n = 0;
+
+	std::thread producer([items]()
+	{
+		StressItem out;
+		uint32_t i = 0;
+
+		while (i < items)
+		{
+			fill(out, i);
+			if (ring.push(out))
+				i++;
+			else
+				std::this_thread::yield();
+		}
+	});
+
+	while (n < items)
+	{
+		if (!ring.pop(item))
+		{
+			std::this_thread::yield();
+			continue;
+		}
+		fill(expected, n);
+		if ((item.sequence != expected.sequence) || (item.check[0] != expected.check[0]) ||
+			(item.check[1] != expected.check[1]) || (item.check[2] != expected.check[2]))
+		{
+			bad++;
+			n = item.sequence; // resynchronize on what arrived
+		}
+		n++;
+	}
+	producer.join();
+	if (ring.pop(item))
+		bad++; // nothing may be left over
+	printf("capacity %3u: %lu items, %lu bad\n", CAPACITY, (unsigned long)items, bad);
+	return(bad);
+}
+
+int main(int argc, char *argv[])
+{
+	uint32_t items = (argc > 1) ? strtoul(argv[1], NULL, 10) : 5000000UL;
+	unsigned long bad;
+
+	bad = run<2>(items);
+	bad += run<64>(items);
+	printf(bad ? "FAILED\n" : "passed\n");
+	return(bad ? 1 : 0);
+}
@@ -0,0 +1,73 @@
+/*
+	BMP180_TeensyCheck.cpp
+	Runs the Teensy library on the simulated sensor
+
+	Built twice by make teensy: against Teensy/src (Teensy_BMP180 on
+	TwoWire) and against Teensy/utilyt (Teensy_BMP180 on the i2c_t3
+	stand-in in sim/), so BMP180_Driver is instantiated with both bus
+	classes. Checks the behaviour sketches written for earlier versions
+	rely on, getTemperature() and getPressure() straight after starting a
+	conversion, and a snapshot from Teensy_BMP180_Scheduler.
+
+	Usage: bmp180teensy, bmp180teensy_t3
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <Teensy_BMP180.h>
+#include <BMP180_Model.h>
+#include <math.h>
+#include <stdio.h>
+
+#ifdef I2C_T3_H
+#define BUS_NAME "i2c_t3"
+typedef i2c_t3 Bus;
+#else
+#define BUS_NAME "TwoWire"
+typedef TwoWire Bus;
+#endif
+
+static int failures = 0;
+
+static void check(const char *what, bool ok)
+{
+	printf("%-44s %s\n", what, ok ? "ok" : "FAILED");
+	if (!ok)
+		failures++;
+}
+
+int main(void)
+{
+	Bus bus;
+	BMP180_Model sensor;
+	Teensy_BMP180 pressure(&bus);
+	Teensy_BMP180_Scheduler<1> sensors;
+	double T, P;
+	char ok;
+
+	bus.attach(sensor);
+	sensor.setConditions(21.5, 987.0);
+	printf("Teensy_BMP180 on %s\n", BUS_NAME);
+	check("begin()", pressure.begin() == 1);
+
+	// no wait between starting and reading: the getters wait themselves
+
+	check("startTemperature()", pressure.startTemperature() != 0);
+	ok = pressure.getTemperature(T);
+	check("getTemperature() right after starting", ok && (fabs(T - 21.5) < 0.2));
+	check("startPressure(3)", pressure.startPressure(3) != 0);
+	ok = pressure.getPressure(P, T);
+	check("getPressure() right after starting", ok && (fabs(P - 987.0) < 0.2));
+
+	sensors.add(pressure);
+	check("scheduler begin()", sensors.begin() == 1);
+	check("scheduler start()", sensors.start() == 1);
+	while (!sensors.poll())
+		simAdvance(100);
+	check("scheduler snapshot", sensors.isValid(0) && (fabs(sensors.pressure(0) - 987.0) < 0.2));
+
+	printf(failures ? "FAILED\n" : "passed\n");
+	return(failures ? 1 : 0);
+}
@@ -0,0 +1,239 @@
+/*
+	BMP180_TelemetryDecoder.cpp
+	Host-side decoder for the BMP180 binary telemetry stream
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <BMP180_TelemetryDecoder.h>
+#include <math.h>
+#include <string.h>
+
+
+BMP180_TelemetryDecoder::BMP180_TelemetryDecoder()
+{
+	fill = 0;
+	queued = 0;
+	taken = 0;
+	header = false;
+	sequenced = false;
+	timeShift = 0;
+	sequence = 0;
+	memset(&cal, 0, sizeof(cal));
+	memset(&coef, 0, sizeof(coef));
+	memset(&counts, 0, sizeof(counts));
+}
+
+
+size_t BMP180_TelemetryDecoder::feed(const uint8_t *data, size_t length)
+// Take bytes a buffer at a time, stopping as soon as a frame yields samples.
+// Bytes after that frame stay buffered for parse() to pick up from next().
+{
+	size_t used = 0;
+
+	while (used < length && taken == queued)
+	{
+		size_t n = sizeof(buffer) - fill;
+
+		if (n > length - used)
+			n = length - used;
+		memcpy(&buffer[fill], &data[used], n);
+		fill += n;
+		used += n;
+		parse();
+	}
+	return(used);
+}
+
+
+bool BMP180_TelemetryDecoder::next(BMP180_TelemetrySample &sample)
+{
+	if (taken == queued)
+		return(false);
+	sample = queue[taken++];
+	if (taken == queued)
+	{
+		taken = 0;
+		queued = 0;
+		parse(); // a frame may be complete in the buffer already
+	}
+	return(true);
+}
+
+
+bool BMP180_TelemetryDecoder::haveHeader(void) const
+{
+	return(header);
+}
+
+
+const BMP180_Calibration &BMP180_TelemetryDecoder::calibration(void) const
+{
+	return(cal);
+}
+
+
+const BMP180_TelemetryStats &BMP180_TelemetryDecoder::stats(void) const
+{
+	return(counts);
+}
+
+
+void BMP180_TelemetryDecoder::parse(void)
+// Decode complete frames from the front of the buffer until one yields samples
+// or the buffer runs out. A frame that fails its CRC costs one byte: the
+// search for the next sync byte starts just after the bad one.
+{
+	uint8_t length;
+	uint16_t crc;
+
+	while (fill > 0 && taken == queued)
+	{
+		if (buffer[0] != BMP180_TELEMETRY_SYNC)
+		{
+			const uint8_t *sync = (const uint8_t *)memchr(buffer, BMP180_TELEMETRY_SYNC, fill);
+			size_t skip = sync ? (size_t)(sync - buffer) : fill;
+
+			counts.skippedBytes += skip;
+			discard(skip);
+			continue;
+		}
+		if (fill < 2)
+			return;
+		length = buffer[1];
+		if (length == 0 || length > BMP180_TELEMETRY_MAX_PAYLOAD)
+		{
+			counts.skippedBytes++;
+			discard(1);
+			continue;
+		}
+		if (fill < (size_t)length + BMP180_TELEMETRY_FRAME_BYTES)
+			return;
+
+		crc = buffer[length + 2] | (buffer[length + 3] << 8);
+		if (crc != BMP180_crc16(&buffer[1], length + 1) || !decodeFrame(&buffer[2], length))
+		{
+			counts.badFrames++;
+			counts.skippedBytes++;
+			discard(1);
+			continue;
+		}
+		discard(length + BMP180_TELEMETRY_FRAME_BYTES);
+	}
+}
+
+
+bool BMP180_TelemetryDecoder::decodeFrame(const uint8_t *payload, uint8_t length)
+// Check and unpack one payload. Samples go to the queue only if the whole
+// frame decodes.
+{
+	const uint8_t *p = payload, *end = payload + length;
+	uint16_t UT[BMP180_TELEMETRY_MAX_SAMPLES];
+	uint32_t UP[BMP180_TELEMETRY_MAX_SAMPLES];
+	double T[BMP180_TELEMETRY_MAX_SAMPLES], P[BMP180_TELEMETRY_MAX_SAMPLES];
+	uint32_t time, a, b, v[3];
+	uint8_t type, frameSequence, oss = 0, shift = 0;
+	size_t n, i;
+
+	if (length < 2)
+		return(false);
+	type = *p++;
+	frameSequence = *p++;
+
+	if (type == BMP180_TELEMETRY_HEADER)
+	{
+		if (length != BMP180_TELEMETRY_HEADER_BYTES || p[0] != BMP180_TELEMETRY_VERSION || p[1] > 16)
+			return(false);
+		timeShift = p[1];
+		memcpy(&cal, &p[3], sizeof(cal));
+		BMP180_computeCoefficients(cal, coef);
+		header = true;
+		n = 0;
+	}
+	else if (type == BMP180_TELEMETRY_RAW || type == BMP180_TELEMETRY_FIXED)
+	{
+		if (type == BMP180_TELEMETRY_RAW)
+		{
+			if (p == end || (*p & ~BMP180_TELEMETRY_PACKED) > 3)
+				return(false);
+			oss = *p & 3;
+			if (*p++ & BMP180_TELEMETRY_PACKED)
+				shift = 8 - oss;
+		}
+		time = a = b = 0;
+		for (n = 0; p < end; n++)
+		{
+			for (i = 0; i < 3; i++)
+			{
+				uint8_t used = BMP180_getVarint(p, end, v[i]);
+
+				if (used == 0)
+					return(false);
+				p += used;
+			}
+			if (n == 0)
+			{
+				time = v[0];
+				a = (type == BMP180_TELEMETRY_RAW) ? v[1] : (uint32_t)BMP180_unzigzag(v[1]);
+				b = v[2];
+			}
+			else
+			{
+				time += v[0];
+				a += BMP180_unzigzag(v[1]);
+				b += BMP180_unzigzag(v[2]);
+			}
+
+			BMP180_TelemetrySample &s = queue[n];
+			s.time = time << timeShift;
+			if (type == BMP180_TELEMETRY_RAW)
+			{
+				s.UT = UT[n] = (uint16_t)a;
+				s.UP = UP[n] = b << shift;
+				s.oss = oss;
+			}
+			else
+			{
+				s.T = (int32_t)a / 100.0;
+				s.P = (int32_t)b / 100.0;
+				s.UT = 0;
+				s.UP = 0;
+				s.oss = 0;
+			}
+		}
+		if (n == 0)
+			return(false);
+
+		if (type == BMP180_TELEMETRY_RAW)
+		{
+			if (header)
+				BMP180_compensateBatch(coef, UT, UP, T, P, n);
+			for (i = 0; i < n; i++)
+			{
+				queue[i].T = header ? T[i] : NAN;
+				queue[i].P = header ? P[i] : NAN;
+			}
+		}
+	}
+	else
+		return(false);
+
+	if (sequenced && frameSequence != (uint8_t)(sequence + 1))
+		counts.lostFrames += (uint8_t)(frameSequence - sequence - 1);
+	sequence = frameSequence;
+	sequenced = true;
+	counts.frames++;
+	counts.samples += n;
+	queued = n;
+	taken = 0;
+	return(true);
+}
+
+
+void BMP180_TelemetryDecoder::discard(size_t n)
+{
+	memmove(buffer, &buffer[n], fill - n);
+	fill -= n;
+}
@@ -0,0 +1,104 @@
+/*
+	BMP180_TelemetryDecoder.h
+	Host-side decoder for the BMP180 binary telemetry stream
+	(see src/BMP180_TelemetryFormat.h and src/BMP180_TelemetryWriter.h)
+
+	Feed it the bytes as they arrive from the serial port, in chunks of
+	any size, and take the samples out as whole frames check out:
+
+		BMP180_TelemetryDecoder decoder;
+		BMP180_TelemetrySample s;
+		while ((n = read(fd, buffer, sizeof(buffer))) > 0)
+			for (p = buffer; n > 0; )
+			{
+				used = decoder.feed(p, n);
+				p += used;
+				n -= used;
+				while (decoder.next(s))
+					use(s.time, s.T, s.P);
+			}
+
+	feed() stops taking bytes while decoded samples are waiting, so
+	nothing is buffered without bound. Damaged frames are dropped and
+	the decoder resynchronizes on the next sync byte. Raw samples are
+	compensated with BMP180_Batch once a header with the calibration has
+	been seen; until then their T and P are NaN (and the times of all
+	samples are in stream ticks rather than microseconds).
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_TelemetryDecoder_h
+#define BMP180_TelemetryDecoder_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <BMP180_TelemetryFormat.h>
+#include <BMP180_Batch.h>
+
+// Most samples one frame can hold (three one-byte varints each)
+#define BMP180_TELEMETRY_MAX_SAMPLES (BMP180_TELEMETRY_MAX_PAYLOAD / 3)
+
+struct BMP180_TelemetrySample
+{
+	uint32_t time; // micros() of the reading, to the stream's time resolution
+	double T; // temperature (deg C)
+	double P; // absolute pressure (mbar)
+	uint32_t UP; // raw pressure reading (raw streams only, otherwise 0)
+	uint16_t UT; // raw temperature word (raw streams only, otherwise 0)
+	uint8_t oss; // oversampling setting (raw streams only, otherwise 0)
+};
+
+struct BMP180_TelemetryStats
+{
+	uint32_t frames; // frames accepted (headers included)
+	uint32_t badFrames; // frames dropped for a bad CRC or contents
+	uint32_t lostFrames; // gaps in the frame sequence numbers
+	uint64_t skippedBytes; // bytes discarded while looking for a frame
+	uint64_t samples; // samples decoded
+};
+
+class BMP180_TelemetryDecoder
+{
+	public:
+		BMP180_TelemetryDecoder();
+
+		size_t feed(const uint8_t *data, size_t length);
+			// pass received bytes to the decoder
+			// returns the number of bytes taken; fewer than length if samples are waiting
+			// (take them with next(), then feed the rest)
+
+		bool next(BMP180_TelemetrySample &sample);
+			// take the next decoded sample
+			// returns true for a sample, false if none is waiting
+
+		bool haveHeader(void) const;
+			// true once a stream header has been received
+
+		const BMP180_Calibration &calibration(void) const;
+			// calibration from the last stream header
+
+		const BMP180_TelemetryStats &stats(void) const;
+			// counts of frames, errors and samples so far
+
+	private:
+		void parse(void);
+		bool decodeFrame(const uint8_t *payload, uint8_t length);
+		void discard(size_t n);
+
+		uint8_t buffer[BMP180_TELEMETRY_MAX_PAYLOAD + BMP180_TELEMETRY_FRAME_BYTES];
+		size_t fill;
+
+		BMP180_TelemetrySample queue[BMP180_TELEMETRY_MAX_SAMPLES];
+		size_t queued, taken;
+
+		bool header, sequenced;
+		uint8_t timeShift, sequence;
+		BMP180_Calibration cal;
+		BMP180_Coefficients coef;
+		BMP180_TelemetryStats counts;
+};
+
+#endif
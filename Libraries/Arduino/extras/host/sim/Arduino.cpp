@@ -0,0 +1,195 @@
+/*
+	Arduino.cpp (host simulation)
+	Virtual clock and digital pins
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include "Arduino.h"
+
+static uint64_t now = 0; // virtual time (us)
+static unsigned int tick = 1; // time per clock or pin read (us)
+static int interruptsOff = 0;
+static int attached = 0; // handlers attached, to skip the pin scan when there are none
+
+static struct
+{
+	SimPinSource source;
+	void *context;
+	uint8_t value; // last level written or read
+	void (*isr)(void);
+	int mode;
+	char pending; // edge seen while interrupts were off
+} pins[SIM_PINS];
+
+
+static int pinLevel(uint8_t pin)
+// Current level of a pin: its device's output if one drives it,
+// else what digitalWrite() left there.
+{
+	if (pins[pin].source)
+		return(pins[pin].source(pins[pin].context));
+	return(pins[pin].value);
+}
+
+
+static void checkInterrupts(void)
+// Fire handlers whose pins changed in the way they asked for.
+{
+	uint8_t pin;
+	int level;
+
+	if (!attached)
+		return;
+	for (pin = 0; pin < SIM_PINS; pin++)
+	{
+		if (!pins[pin].isr)
+			continue;
+		level = pinLevel(pin);
+		if (level != pins[pin].value)
+		{
+			pins[pin].value = level;
+			if ((pins[pin].mode == CHANGE) ||
+				((pins[pin].mode == RISING) && (level == HIGH)) ||
+				((pins[pin].mode == FALLING) && (level == LOW)))
+				pins[pin].pending = 1;
+		}
+		if (pins[pin].pending && !interruptsOff)
+		{
+			pins[pin].pending = 0;
+			pins[pin].isr();
+		}
+	}
+}
+
+
+void simAdvance(uint64_t us)
+{
+	now += us;
+	checkInterrupts();
+}
+
+
+uint64_t simMicros(void)
+{
+	return(now);
+}
+
+
+void simSetTick(unsigned int us)
+{
+	tick = us;
+}
+
+
+void simReset(void)
+{
+	now = 0;
+	interruptsOff = 0;
+	attached = 0;
+	memset(pins, 0, sizeof(pins));
+}
+
+
+void simSetPinSource(uint8_t pin, SimPinSource source, void *context)
+{
+	if (pin >= SIM_PINS)
+		return;
+	pins[pin].source = source;
+	pins[pin].context = context;
+	if (source)
+		pins[pin].value = source(context);
+}
+
+
+unsigned long millis(void)
+{
+	simAdvance(tick);
+	return((unsigned long)(now / 1000));
+}
+
+
+unsigned long micros(void)
+{
+	simAdvance(tick);
+	return((unsigned long)now);
+}
+
+
+void delay(unsigned long ms)
+{
+	simAdvance((uint64_t)ms * 1000);
+}
+
+
+void delayMicroseconds(unsigned int us)
+{
+	simAdvance(us);
+}
+
+
+void yield(void)
+{
+	simAdvance(tick);
+}
+
+
+void pinMode(uint8_t pin, uint8_t mode)
+{
+	if ((pin < SIM_PINS) && (mode == INPUT_PULLUP) && !pins[pin].source)
+		pins[pin].value = HIGH;
+}
+
+
+int digitalRead(uint8_t pin)
+{
+	if (pin >= SIM_PINS)
+		return(LOW);
+	simAdvance(tick);
+	return(pinLevel(pin));
+}
+
+
+void digitalWrite(uint8_t pin, uint8_t value)
+{
+	if (pin < SIM_PINS)
+		pins[pin].value = value ? HIGH : LOW;
+}
+
+
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode)
+{
+	if (interrupt >= SIM_PINS)
+		return;
+	if (!pins[interrupt].isr)
+		attached++;
+	pins[interrupt].value = pinLevel(interrupt);
+	pins[interrupt].mode = mode;
+	pins[interrupt].pending = 0;
+	pins[interrupt].isr = isr;
+}
+
+
+void detachInterrupt(uint8_t interrupt)
+{
+	if ((interrupt < SIM_PINS) && pins[interrupt].isr)
+	{
+		pins[interrupt].isr = 0;
+		attached--;
+	}
+}
+
+
+void noInterrupts(void)
+{
+	interruptsOff = 1;
+}
+
+
+void interrupts(void)
+{
+	interruptsOff = 0;
+	checkInterrupts();
+}
@@ -0,0 +1,102 @@
+/*
+	Arduino.h (host simulation)
+	The parts of the Arduino core the BMP180 libraries use, for desktop builds
+
+	Time is virtual. It only moves when the code under test waits (delay(),
+	delayMicroseconds()), when I2C traffic takes bus time (see Wire.h), or
+	by a small tick on every millis()/micros()/digitalRead() call, so that
+	polling loops such as "while (pressure.poll() == BMP180_POLL_PENDING);"
+	still finish. Runs are therefore repeatable and as fast as the host.
+
+	Digital pins read LOW unless a simulated device drives them (see
+	simSetPinSource(); BMP180_Model drives its EOC pin this way), and
+	attachInterrupt() handlers fire on the matching edges as time passes.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+typedef bool boolean;
+typedef uint8_t byte;
+
+#define HIGH 1
+#define LOW 0
+
+#define INPUT 0
+#define OUTPUT 1
+#define INPUT_PULLUP 2
+
+#define CHANGE 1
+#define FALLING 2
+#define RISING 3
+
+#define SIM_PINS 64 // number of simulated digital pins
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+void yield(void);
+
+void pinMode(uint8_t pin, uint8_t mode);
+int digitalRead(uint8_t pin);
+void digitalWrite(uint8_t pin, uint8_t value);
+#define digitalPinToInterrupt(p) ((p) < SIM_PINS ? (int)(p) : -1)
+void attachInterrupt(uint8_t interrupt, void (*isr)(void), int mode);
+void detachInterrupt(uint8_t interrupt);
+void noInterrupts(void);
+void interrupts(void);
+
+class Print
+{
+	public:
+		virtual ~Print() {}
+		virtual size_t write(uint8_t b) = 0;
+		virtual size_t write(const uint8_t *buffer, size_t size)
+		{
+			size_t n;
+			for (n = 0; n < size; n++)
+				if (!write(buffer[n]))
+					break;
+			return(n);
+		}
+		size_t write(const char *str)
+		{
+			return(write((const uint8_t *)str, strlen(str)));
+		}
+		size_t print(const char *str)
+		{
+			return(write(str));
+		}
+		virtual void flush(void) {}
+};
+
+// Host simulation controls (not part of the Arduino API)
+
+uint64_t simMicros(void);
+	// full 64-bit virtual time (microseconds since start)
+
+void simAdvance(uint64_t us);
+	// let virtual time pass; fires any attached pin interrupts on the way
+
+void simSetTick(unsigned int us);
+	// time that passes on each millis(), micros() or digitalRead() call (default 1 us, 0 = none)
+
+void simReset(void);
+	// restart virtual time at 0 and forget pin sources and interrupts
+
+typedef int (*SimPinSource)(void *context);
+void simSetPinSource(uint8_t pin, SimPinSource source, void *context);
+	// let a simulated device drive a pin; source returns HIGH or LOW for the current time
+	// source = 0 releases the pin
+
+#endif
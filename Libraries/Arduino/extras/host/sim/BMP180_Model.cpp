@@ -0,0 +1,333 @@
+/*
+	BMP180_Model.cpp
+	Simulated BMP180 for host builds
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include "BMP180_Model.h"
+
+#define BMP180_MODEL_REG_CAL 0xAA
+#define BMP180_MODEL_REG_ID 0xD0
+#define BMP180_MODEL_REG_RESET 0xE0
+#define BMP180_MODEL_REG_CONTROL 0xF4
+#define BMP180_MODEL_REG_RESULT 0xF6
+
+#define BMP180_MODEL_CHIP_ID 0x55
+#define BMP180_MODEL_RESET 0xB6
+#define BMP180_MODEL_SCO 0x20
+#define BMP180_MODEL_MEASUREMENT 0x1F // measurement control field of 0xF4
+#define BMP180_MODEL_TEMPERATURE 0x0E
+#define BMP180_MODEL_PRESSURE 0x14
+
+static const uint16_t conversionTime[4] = { 4500, 7500, 13500, 25500 }; // us per oversampling
+static const double noiseRMS[4] = { 6.0, 5.0, 4.0, 3.0 }; // Pa per oversampling
+
+
+BMP180_Model::BMP180_Model(uint8_t address)
+{
+	// datasheet example calibration
+	static const BMP180_Calibration example = { 408, -72, -14383, 32741, 32757, 23153, 6190, 4, -32768, -8711, 2868 };
+
+	this->address = address;
+	conversions = 0;
+	earlyReads = 0;
+	T = 15.0;
+	P = 1013.25;
+	noise = 0;
+	noiseState = 1;
+	setCalibration(example);
+	reset();
+}
+
+
+void BMP180_Model::setCalibration(const BMP180_Calibration &cal)
+{
+	const int16_t *words;
+	uint8_t i;
+
+	this->cal = cal;
+	// stored MSB first, in the same order as the struct
+	words = (const int16_t *)&this->cal;
+	for (i = 0; i < 11; i++)
+	{
+		regs[BMP180_MODEL_REG_CAL + (2 * i)] = (uint16_t)words[i] >> 8;
+		regs[BMP180_MODEL_REG_CAL + (2 * i) + 1] = (uint16_t)words[i] & 0xFF;
+	}
+}
+
+
+void BMP180_Model::getCalibration(BMP180_Calibration &cal)
+{
+	cal = this->cal;
+}
+
+
+void BMP180_Model::setConditions(double T, double P)
+{
+	this->T = T;
+	this->P = P;
+}
+
+
+double BMP180_Model::temperatureAt(double seconds)
+{
+	(void)seconds;
+	return(T);
+}
+
+
+double BMP180_Model::pressureAt(double seconds)
+{
+	(void)seconds;
+	return(P);
+}
+
+
+void BMP180_Model::setNoise(char enable, uint32_t seed)
+{
+	noise = enable;
+	noiseState = seed ? seed : 1;
+}
+
+
+void BMP180_Model::setEOCPin(uint8_t pin)
+{
+	simSetPinSource(pin, eocLevel, this);
+}
+
+
+int BMP180_Model::eocLevel(void *context)
+{
+	BMP180_Model *model = (BMP180_Model *)context;
+
+	model->update();
+	return(model->busy ? LOW : HIGH);
+}
+
+
+char BMP180_Model::converting(void)
+{
+	update();
+	return(busy);
+}
+
+
+void BMP180_Model::reset(void)
+{
+	regs[BMP180_MODEL_REG_ID] = BMP180_MODEL_CHIP_ID;
+	regs[BMP180_MODEL_REG_CONTROL] = 0;
+	regs[BMP180_MODEL_REG_RESULT] = 0x80;
+	regs[BMP180_MODEL_REG_RESULT + 1] = 0;
+	regs[BMP180_MODEL_REG_RESULT + 2] = 0;
+	pointer = 0;
+	busy = 0;
+	command = 0;
+	convEnd = 0;
+}
+
+
+uint8_t BMP180_Model::i2cAddress(void)
+{
+	return(address);
+}
+
+
+char BMP180_Model::i2cWrite(const uint8_t *data, uint8_t length)
+// First byte sets the register pointer, any further bytes are written from there.
+{
+	uint8_t i;
+
+	update();
+	if (length == 0)
+		return(1);
+	pointer = data[0];
+	for (i = 1; i < length; i++, pointer++)
+	{
+		if (pointer == BMP180_MODEL_REG_CONTROL)
+			startConversion(data[i]);
+		else if ((pointer == BMP180_MODEL_REG_RESET) && (data[i] == BMP180_MODEL_RESET))
+			reset();
+		// everything else is read-only
+	}
+	return(1);
+}
+
+
+uint8_t BMP180_Model::i2cRead(uint8_t *data, uint8_t length)
+// Reads from the register pointer, which advances with each byte.
+{
+	uint8_t i;
+
+	update();
+	if (busy && (pointer >= BMP180_MODEL_REG_RESULT) && (pointer <= BMP180_MODEL_REG_RESULT + 2))
+		earlyReads++;
+	for (i = 0; i < length; i++)
+		data[i] = regs[pointer++];
+	return(length);
+}
+
+
+void BMP180_Model::startConversion(uint8_t command)
+{
+	uint8_t oss;
+
+	// writing SCO = 1 with a valid measurement field starts a conversion
+	regs[BMP180_MODEL_REG_CONTROL] = command & ~BMP180_MODEL_SCO;
+	if (!(command & BMP180_MODEL_SCO))
+		return;
+	if ((command & BMP180_MODEL_MEASUREMENT) == BMP180_MODEL_TEMPERATURE)
+		oss = 0;
+	else if ((command & BMP180_MODEL_MEASUREMENT) == BMP180_MODEL_PRESSURE)
+		oss = command >> 6;
+	else
+		return;
+
+	this->command = command;
+	regs[BMP180_MODEL_REG_CONTROL] |= BMP180_MODEL_SCO;
+	busy = 1;
+	convEnd = simMicros() + conversionTime[oss];
+	conversions++;
+}
+
+
+void BMP180_Model::update(void)
+{
+	if (busy && (simMicros() >= convEnd))
+		finishConversion();
+}
+
+
+void BMP180_Model::finishConversion(void)
+// Latch the reading for the conditions at the end of the conversion.
+{
+	double seconds, Pa;
+	uint16_t UT;
+	uint32_t UP;
+	uint8_t oss;
+
+	seconds = convEnd / 1000000.0;
+	UT = rawTemperature(temperatureAt(seconds));
+	if ((command & BMP180_MODEL_MEASUREMENT) == BMP180_MODEL_TEMPERATURE)
+	{
+		regs[BMP180_MODEL_REG_RESULT] = UT >> 8;
+		regs[BMP180_MODEL_REG_RESULT + 1] = UT & 0xFF;
+	}
+	else
+	{
+		oss = command >> 6;
+		Pa = pressureAt(seconds) * 100.0;
+		if (noise)
+			Pa += gaussian() * noiseRMS[oss];
+		UP = rawPressure(Pa / 100.0, oss, computeB5(UT)) << (8 - oss);
+		regs[BMP180_MODEL_REG_RESULT] = (UP >> 16) & 0xFF;
+		regs[BMP180_MODEL_REG_RESULT + 1] = (UP >> 8) & 0xFF;
+		regs[BMP180_MODEL_REG_RESULT + 2] = UP & 0xFF;
+	}
+	regs[BMP180_MODEL_REG_CONTROL] &= ~BMP180_MODEL_SCO;
+	busy = 0;
+}
+
+
+int32_t BMP180_Model::computeB5(int32_t UT)
+{
+	int32_t X1, X2;
+
+	X1 = ((UT - (int32_t)cal.AC6) * (int32_t)cal.AC5) >> 15;
+	X2 = ((int32_t)cal.MC << 11) / (X1 + cal.MD);
+	return(X1 + X2);
+}
+
+
+int32_t BMP180_Model::compensate(int32_t UP, uint8_t oss, int32_t B5)
+{
+	int32_t B6, X1, X2, X3, B3, p;
+	uint32_t B4, B7;
+
+	B6 = B5 - 4000;
+	X1 = (cal.VB2 * ((B6 * B6) >> 12)) >> 11;
+	X2 = (cal.AC2 * B6) >> 11;
+	X3 = X1 + X2;
+	B3 = ((((int32_t)cal.AC1 * 4 + X3) << oss) + 2) >> 2;
+	X1 = (cal.AC3 * B6) >> 13;
+	X2 = (cal.VB1 * ((B6 * B6) >> 12)) >> 16;
+	X3 = ((X1 + X2) + 2) >> 2;
+	B4 = (cal.AC4 * (uint32_t)(X3 + 32768)) >> 15;
+	B7 = ((uint32_t)UP - B3) * (uint32_t)(50000 >> oss);
+	if (B7 < 0x80000000)
+		p = (B7 * 2) / B4;
+	else
+		p = (B7 / B4) * 2;
+	X1 = (p >> 8) * (p >> 8);
+	X1 = (X1 * 3038) >> 16;
+	X2 = (-7357 * p) >> 16;
+	return(p + ((X1 + X2 + 3791) >> 4));
+}
+
+
+uint16_t BMP180_Model::rawTemperature(double T)
+// Smallest UT that reads as T or warmer. Temperature rises with UT above
+// the pole of the X2 term, so a binary search from there finds it.
+{
+	int32_t lo, hi, mid, target;
+
+	target = (int32_t)floor((T * 10.0) + 0.5);
+	lo = (int32_t)cal.AC6 - (((int32_t)cal.MD << 15) / (int32_t)cal.AC5) + 1;
+	if (lo < 0)
+		lo = 0;
+	hi = 65535;
+	while (lo < hi)
+	{
+		mid = (lo + hi) / 2;
+		if (((computeB5(mid) + 8) >> 4) < target)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return((uint16_t)lo);
+}
+
+
+uint32_t BMP180_Model::rawPressure(double P, uint8_t oss, int32_t B5)
+// Smallest UP (16 + oss bits) that reads as P or higher.
+{
+	int32_t lo, hi, mid, target, B6, X1, X2, X3, B3;
+
+	target = (int32_t)floor((P * 100.0) + 0.5);
+	// B3 (the offset) marks the bottom of the usable range
+	B6 = B5 - 4000;
+	X1 = (cal.VB2 * ((B6 * B6) >> 12)) >> 11;
+	X2 = (cal.AC2 * B6) >> 11;
+	X3 = X1 + X2;
+	B3 = ((((int32_t)cal.AC1 * 4 + X3) << oss) + 2) >> 2;
+	lo = (B3 > 0) ? B3 : 0;
+	hi = (1L << (16 + oss)) - 1;
+	while (lo < hi)
+	{
+		mid = (lo + hi) / 2;
+		if (compensate(mid, oss, B5) < target)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	return((uint32_t)lo);
+}
+
+
+double BMP180_Model::gaussian(void)
+// Standard normal noise from a repeatable xorshift generator (Box-Muller).
+{
+	double u1, u2;
+
+	noiseState ^= noiseState << 13;
+	noiseState ^= noiseState >> 17;
+	noiseState ^= noiseState << 5;
+	u1 = (noiseState + 1.0) / 4294967297.0;
+	noiseState ^= noiseState << 13;
+	noiseState ^= noiseState >> 17;
+	noiseState ^= noiseState << 5;
+	u2 = noiseState / 4294967296.0;
+	return(sqrt(-2.0 * log(u1)) * cos(6.283185307179586 * u2));
+}
@@ -0,0 +1,116 @@
+/*
+	BMP180_Model.h
+	Simulated BMP180 for host builds
+
+	Attach it to a simulated bus and the unmodified drivers talk to it as
+	if it were the real sensor:
+
+		BMP180_Model sensor;
+		Wire.attach(sensor);
+		sensor.setConditions(21.5, 987.0); // deg C, mbar
+
+		SFE_BMP180 pressure;
+		pressure.begin();
+		...
+
+	What it models:
+	- calibration EEPROM at 0xAA-0xBF (datasheet example values by default)
+	- chip id 0x55 at 0xD0, soft reset (0xB6 to 0xE0)
+	- control register 0xF4 with the SCO bit set while a conversion runs
+	- conversion times of 4.5 ms (temperature) and 4.5 / 7.5 / 13.5 / 25.5 ms
+	  (pressure, oversampling 0-3), on the virtual clock in Arduino.h;
+	  the result registers keep the old reading until the time is up
+	- the EOC pin (setEOCPin()), LOW while converting
+	- raw readings that the datasheet's integer algorithm turns back into
+	  the simulated temperature and pressure, optionally with the
+	  datasheet's RMS pressure noise for each oversampling setting
+
+	Temperature and pressure follow setConditions(), or any profile over
+	time by overriding temperatureAt() and pressureAt().
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_Model_h
+#define BMP180_Model_h
+
+#include "Wire.h"
+#include <BMP180_Calibration.h>
+
+class BMP180_Model : public SimI2CDevice
+{
+	public:
+		BMP180_Model(uint8_t address = 0x77);
+			// datasheet example calibration, 15 deg C, 1013.25 mbar, no noise
+
+		virtual ~BMP180_Model() {}
+
+		void setCalibration(const BMP180_Calibration &cal);
+			// replace the calibration EEPROM contents
+
+		void getCalibration(BMP180_Calibration &cal);
+			// read back the calibration EEPROM contents
+
+		void setConditions(double T, double P);
+			// constant conditions for the default profile
+			// T: temperature (deg C)
+			// P: absolute pressure (mbar)
+
+		virtual double temperatureAt(double seconds);
+			// temperature (deg C) at a virtual time, override for a profile
+
+		virtual double pressureAt(double seconds);
+			// absolute pressure (mbar) at a virtual time, override for a profile
+
+		void setNoise(char enable, uint32_t seed = 1);
+			// add datasheet RMS pressure noise (6 / 5 / 4 / 3 Pa for oversampling 0-3)
+			// seed: start of the repeatable noise sequence
+
+		void setEOCPin(uint8_t pin);
+			// drive a simulated digital pin as the EOC output
+
+		char converting(void);
+			// returns 1 while a conversion is in progress (SCO set)
+
+		unsigned long conversions; // conversions started
+		unsigned long earlyReads; // result reads while a conversion was still running
+
+		// SimI2CDevice
+		uint8_t i2cAddress(void);
+		char i2cWrite(const uint8_t *data, uint8_t length);
+		uint8_t i2cRead(uint8_t *data, uint8_t length);
+
+	private:
+		void reset(void);
+			// power-on / soft-reset register state
+
+		void update(void);
+			// finish the running conversion if its time is up
+
+		void startConversion(uint8_t command);
+		void finishConversion(void);
+
+		int32_t computeB5(int32_t UT);
+		int32_t compensate(int32_t UP, uint8_t oss, int32_t B5);
+			// datasheet integer algorithm, for inverting the readings
+
+		uint16_t rawTemperature(double T);
+		uint32_t rawPressure(double P, uint8_t oss, int32_t B5);
+			// raw readings the algorithm turns into T (deg C) / P (mbar)
+
+		double gaussian(void);
+
+		static int eocLevel(void *context);
+
+		uint8_t address, regs[256], pointer;
+		BMP180_Calibration cal;
+		double T, P;
+		char busy, noise;
+		uint8_t command;
+		uint64_t convEnd;
+		uint32_t noiseState;
+};
+
+#endif
@@ -0,0 +1,245 @@
+/*
+	Wire.cpp (host simulation)
+	TwoWire stand-in that routes I2C transactions to simulated devices
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include "Wire.h"
+
+TwoWire Wire;
+TwoWire Wire1;
+TwoWire Wire2;
+TwoWire Wire3;
+
+
+TwoWire::TwoWire()
+{
+	memset(devices, 0, sizeof(devices));
+	clock = 100000;
+	txAddress = 0;
+	txLength = 0;
+	txOverflow = 0;
+	rxLength = 0;
+	rxIndex = 0;
+	transactions = 0;
+	bytes = 0;
+	stops = 0;
+	busMicros = 0;
+}
+
+
+void TwoWire::begin(void)
+{
+	rxLength = 0;
+	rxIndex = 0;
+}
+
+
+void TwoWire::end(void)
+{
+}
+
+
+void TwoWire::setClock(uint32_t frequency)
+{
+	if (frequency)
+		clock = frequency;
+}
+
+
+char TwoWire::attach(SimI2CDevice &device)
+{
+	uint8_t i;
+
+	for (i = 0; i < SIM_WIRE_DEVICES; i++)
+		if (!devices[i] || (devices[i] == &device))
+		{
+			devices[i] = &device;
+			return(1);
+		}
+	return(0);
+}
+
+
+void TwoWire::detach(SimI2CDevice &device)
+{
+	uint8_t i;
+
+	for (i = 0; i < SIM_WIRE_DEVICES; i++)
+		if (devices[i] == &device)
+			devices[i] = 0;
+}
+
+
+SimI2CDevice *TwoWire::find(uint8_t address)
+{
+	uint8_t i;
+
+	for (i = 0; i < SIM_WIRE_DEVICES; i++)
+		if (devices[i] && (devices[i]->i2cAddress() == address))
+			return(devices[i]);
+	return(0);
+}
+
+
+void TwoWire::busTime(unsigned int bytesOnWire)
+// Let the time for some bytes pass on the bus: 8 data bits and an ACK each.
+{
+	uint64_t us;
+
+	us = ((uint64_t)bytesOnWire * 9 * 1000000 + clock - 1) / clock;
+	bytes += bytesOnWire;
+	busMicros += us;
+	simAdvance(us);
+}
+
+
+void TwoWire::busStop(void)
+// A STOP, and the bus free time before the next START: about one bit time.
+{
+	uint64_t us;
+
+	us = (1000000 + clock - 1) / clock;
+	stops++;
+	busMicros += us;
+	simAdvance(us);
+}
+
+
+void TwoWire::beginTransmission(uint8_t address)
+{
+	txAddress = address;
+	txLength = 0;
+	txOverflow = 0;
+}
+
+
+void TwoWire::beginTransmission(int address)
+{
+	beginTransmission((uint8_t)address);
+}
+
+
+size_t TwoWire::write(uint8_t data)
+{
+	if (txLength >= BUFFER_LENGTH)
+	{
+		txOverflow = 1;
+		return(0);
+	}
+	txBuffer[txLength++] = data;
+	return(1);
+}
+
+
+size_t TwoWire::write(const uint8_t *data, size_t length)
+{
+	size_t n;
+
+	for (n = 0; n < length; n++)
+		if (!write(data[n]))
+			break;
+	return(n);
+}
+
+
+uint8_t TwoWire::endTransmission(void)
+{
+	return(endTransmission((uint8_t)1));
+}
+
+
+uint8_t TwoWire::endTransmission(uint8_t sendStop)
+// sendStop 0 leaves the bus held, so the next transaction begins with a repeated start.
+// A NACK always ends the transaction with a STOP.
+// Returns the Wire codes: 0 success, 1 data too long, 2 address NACK, 3 data NACK
+{
+	SimI2CDevice *device;
+
+	if (txOverflow)
+		return(1);
+	transactions++;
+	busTime(1);
+	device = find(txAddress);
+	if (!device)
+	{
+		busStop();
+		return(2);
+	}
+	busTime(txLength);
+	if (!device->i2cWrite(txBuffer, txLength))
+	{
+		busStop();
+		return(3);
+	}
+	if (sendStop)
+		busStop();
+	return(0);
+}
+
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop)
+{
+	SimI2CDevice *device;
+
+	if (quantity > BUFFER_LENGTH)
+		quantity = BUFFER_LENGTH;
+	rxIndex = 0;
+	rxLength = 0;
+	transactions++;
+	busTime(1);
+	device = find(address);
+	if (!device)
+	{
+		busStop();
+		return(0);
+	}
+	rxLength = device->i2cRead(rxBuffer, quantity);
+	busTime(quantity);
+	if (sendStop)
+		busStop();
+	return(rxLength);
+}
+
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity)
+{
+	return(requestFrom(address, quantity, (uint8_t)1));
+}
+
+
+uint8_t TwoWire::requestFrom(int address, int quantity)
+{
+	return(requestFrom((uint8_t)address, (uint8_t)quantity, (uint8_t)1));
+}
+
+
+uint8_t TwoWire::requestFrom(int address, int quantity, int sendStop)
+{
+	return(requestFrom((uint8_t)address, (uint8_t)quantity, (uint8_t)sendStop));
+}
+
+
+int TwoWire::available(void)
+{
+	return(rxLength - rxIndex);
+}
+
+
+int TwoWire::read(void)
+{
+	if (rxIndex >= rxLength)
+		return(-1);
+	return(rxBuffer[rxIndex++]);
+}
+
+
+int TwoWire::peek(void)
+{
+	if (rxIndex >= rxLength)
+		return(-1);
+	return(rxBuffer[rxIndex]);
+}
@@ -0,0 +1,97 @@
+/*
+	Wire.h (host simulation)
+	TwoWire stand-in that routes I2C transactions to simulated devices
+
+	Same calls and return codes as the Arduino Wire library. Each bus has
+	its own devices (attach()) and clock (setClock(), default 100 kHz);
+	every transaction advances virtual time by its length on the wire
+	(9 bit times per byte, address byte included, plus one bit time for
+	each STOP and the bus free time after it; a repeated start saves
+	that), so driver timing on the host follows a real bus at the
+	configured speed.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include "Arduino.h"
+
+#define BUFFER_LENGTH 32
+#define SIM_WIRE_DEVICES 8 // devices per simulated bus
+
+class SimI2CDevice
+	// a simulated I2C slave, see BMP180_Model
+{
+	public:
+		virtual ~SimI2CDevice() {}
+
+		virtual uint8_t i2cAddress(void) = 0;
+			// 7-bit slave address
+
+		virtual char i2cWrite(const uint8_t *data, uint8_t length) = 0;
+			// a write transaction: register pointer, then data bytes
+			// returns 1 if the device ACKed every byte
+
+		virtual uint8_t i2cRead(uint8_t *data, uint8_t length) = 0;
+			// a read transaction from the current register pointer
+			// returns the number of bytes supplied
+};
+
+class TwoWire
+{
+	public:
+		TwoWire();
+
+		void begin(void);
+		void end(void);
+		void setClock(uint32_t frequency);
+
+		void beginTransmission(uint8_t address);
+		void beginTransmission(int address);
+		uint8_t endTransmission(void);
+		uint8_t endTransmission(uint8_t sendStop);
+		size_t write(uint8_t data);
+		size_t write(const uint8_t *data, size_t length);
+
+		uint8_t requestFrom(uint8_t address, uint8_t quantity);
+		uint8_t requestFrom(uint8_t address, uint8_t quantity, uint8_t sendStop);
+		uint8_t requestFrom(int address, int quantity);
+		uint8_t requestFrom(int address, int quantity, int sendStop);
+		int available(void);
+		int read(void);
+		int peek(void);
+
+		// Host simulation controls (not part of the Arduino API)
+
+		char attach(SimI2CDevice &device);
+			// put a device on this bus; returns 0 if the bus is full
+
+		void detach(SimI2CDevice &device);
+			// take a device off this bus
+
+		unsigned long transactions; // completed address phases (ACKed or not)
+		unsigned long bytes; // bytes on the wire, address bytes included
+		unsigned long stops; // STOP conditions (transactions ended without a repeated start)
+		uint64_t busMicros; // virtual time spent on the wire
+
+	private:
+		SimI2CDevice *find(uint8_t address);
+		void busTime(unsigned int bytesOnWire);
+		void busStop(void);
+
+		SimI2CDevice *devices[SIM_WIRE_DEVICES];
+		uint32_t clock;
+		uint8_t txAddress, txBuffer[BUFFER_LENGTH], txLength, txOverflow;
+		uint8_t rxBuffer[BUFFER_LENGTH], rxLength, rxIndex;
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+extern TwoWire Wire2;
+extern TwoWire Wire3;
+
+#endif
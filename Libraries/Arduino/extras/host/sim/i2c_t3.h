@@ -0,0 +1,68 @@
+/*
+	i2c_t3.h (host simulation)
+	Enough of the Teensy i2c_t3 library for Teensy_BMP180 from utilyt.
+
+	A class of its own rather than another name for TwoWire, with the
+	i2c_t3 signatures the driver meets (the i2c_stop enum, size_t lengths,
+	the Wire-compatible overloads), so that host builds instantiate
+	BMP180_Driver<i2c_t3> the way a Teensy build does. The traffic goes
+	to a simulated TwoWire bus underneath.
+
+	The real library defines Wire, Wire1, ... as i2c_t3 and cannot be used
+	together with Wire.h; here the two coexist, so declare buses yourself:
+
+		i2c_t3 bus;
+		BMP180_Model sensor;
+		bus.attach(sensor);
+		Teensy_BMP180 pressure(&bus);
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef I2C_T3_H
+#define I2C_T3_H
+
+#include "Wire.h"
+
+enum i2c_stop {I2C_NOSTOP, I2C_STOP};
+
+class i2c_t3
+{
+	public:
+		i2c_t3(uint8_t i2c_bus = 0) {}
+
+		void begin(void) {bus.begin();}
+		void setClock(uint32_t frequency) {bus.setClock(frequency);}
+
+		void beginTransmission(uint8_t address) {bus.beginTransmission(address);}
+		inline void beginTransmission(int address) {beginTransmission((uint8_t)address);}
+		uint8_t endTransmission(i2c_stop sendStop, uint32_t timeout) {return(bus.endTransmission((uint8_t)(sendStop == I2C_STOP)));}
+		inline uint8_t endTransmission(i2c_stop sendStop) {return(endTransmission(sendStop, 0));}
+		inline uint8_t endTransmission(uint8_t sendStop) {return(endTransmission((i2c_stop)sendStop, 0));}
+		inline uint8_t endTransmission(void) {return(endTransmission(I2C_STOP, 0));}
+		size_t write(uint8_t data) {return(bus.write(data));}
+		size_t write(const uint8_t *data, size_t quantity) {return(bus.write(data, quantity));}
+
+		size_t requestFrom(uint8_t addr, size_t len, i2c_stop sendStop, uint32_t timeout)
+		{
+			return(bus.requestFrom(addr, (uint8_t)len, (uint8_t)(sendStop == I2C_STOP)));
+		}
+		inline size_t requestFrom(uint8_t addr, size_t len, i2c_stop sendStop) {return(requestFrom(addr, len, sendStop, 0));}
+		inline size_t requestFrom(uint8_t addr, size_t len) {return(requestFrom(addr, len, I2C_STOP, 0));}
+		inline size_t requestFrom(int addr, int len) {return(requestFrom((uint8_t)addr, (size_t)len, I2C_STOP, 0));}
+		inline uint8_t requestFrom(uint8_t addr, uint8_t len, uint8_t sendStop) {return((uint8_t)requestFrom(addr, (size_t)len, (i2c_stop)sendStop, 0));}
+		int available(void) {return(bus.available());}
+		int read(void) {return(bus.read());}
+		int peek(void) {return(bus.peek());}
+
+		// Host simulation controls (not part of the i2c_t3 API)
+
+		char attach(SimI2CDevice &device) {return(bus.attach(device));}
+		void detach(SimI2CDevice &device) {bus.detach(device);}
+
+		TwoWire bus; // the simulated bus, with its traffic counters
+};
+
+#endif
@@ -0,0 +1,244 @@
+/*
+	BMP180_BlockLogger.h
+	Double-buffered block logger for the columnar BMP180 log format
+	(see BMP180_LogFormat.h)
+
+	BMP180_LogWriter writes a block out from inside append(), so the
+	reading that fills a block waits for the storage. This logger keeps
+	two blocks instead: append() only copies the sample into the block
+	being filled, and when that block is full it is handed over whole and
+	sampling carries on in the other one. service() writes handed-over
+	blocks to a BMP180_LogSink (see BMP180_LogSink.h). If storage falls so
+	far behind that both blocks are waiting, new samples are dropped and
+	counted rather than waited for.
+
+	append() and service() follow the rules of BMP180_RingBuffer: one
+	context appends (loop(), an interrupt, a task or core), one context
+	services, and neither ever waits for the other. When both run in
+	loop(), a slow write still delays the next reading; sample from an
+	interrupt or another task to keep sampling through it.
+
+	Files are the same as BMP180_LogWriter's, so BMP180_LogReader reads
+	them (extras/host). RAM use is two blocks of
+	BMP180_logBlockBytes(BLOCK_SAMPLES): 22 samples (2 x 256 bytes) suits
+	an Uno, 45 (2 x 504 bytes, about one SD sector each) bigger boards.
+
+	Example:
+
+		BMP180_BlockLogger<22> logger(sink);
+		BMP180_Calibration cal;
+		pressure.getCalibration(cal);
+		logger.begin(cal, 1); // timestamps from BMP180_Sample.time (micros())
+		...
+		sampling side:  logger.append(pressure.measure(0));
+		storage side:   logger.service();
+		...
+		logger.flush(); // once sampling has stopped
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_BlockLogger_h
+#define BMP180_BlockLogger_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <BMP180_LogFormat.h>
+#include <BMP180_LogSink.h>
+#include <BMP180_RingBuffer.h>
+#include <BMP180_Sample.h>
+
+struct BMP180_LoggerStats
+{
+	uint32_t samples; // samples stored in blocks
+	uint32_t dropped; // samples lost because both blocks were waiting for storage
+	uint32_t blocks; // blocks written to the sink
+	uint32_t writeErrors; // blocks the sink failed to write (their samples are lost)
+	uint32_t flushLast; // time the last block write took (us)
+	uint32_t flushMax; // longest block write (us)
+	uint32_t flushTotal; // time of all block writes (us); divide by blocks for the average
+};
+
+template <uint16_t BLOCK_SAMPLES>
+class BMP180_BlockLogger
+{
+	static_assert(BLOCK_SAMPLES >= 1, "BLOCK_SAMPLES must be at least 1");
+
+	public:
+		BMP180_BlockLogger(BMP180_LogSink &sink) : sink(sink), filled(0), written(0), count(0)
+		{
+			resetStats();
+		}
+
+		char begin(const BMP180_Calibration &cal, uint32_t timeUnit)
+			// write the file header (straight to the sink, so before sampling starts)
+			// cal: calibration words of the logged sensor (SFE_BMP180::getCalibration())
+			// timeUnit: microseconds per timestamp tick (1 for BMP180_Sample.time or micros(),
+			// 1000 for millis())
+			// returns 1 for success, 0 if the sink failed
+		{
+			BMP180_LogHeader header;
+
+			memset(&header, 0, sizeof(header));
+			memcpy(header.magic, BMP180_LOG_MAGIC, sizeof(header.magic));
+			header.version = BMP180_LOG_VERSION;
+			header.blockSamples = BLOCK_SAMPLES;
+			header.timeUnit = timeUnit;
+			header.cal = cal;
+			memset(blocks, 0, sizeof(blocks));
+			filled = 0;
+			written = 0;
+			count = 0;
+			resetStats();
+			return(sink.write(&header, sizeof(header)));
+		}
+
+		char append(uint32_t time, uint16_t UT, uint32_t UP, uint8_t oss)
+			// add one raw sample (sampling side only); never writes to the sink
+			// returns 1 for success, 0 if the sample was dropped (both blocks waiting for storage)
+		{
+			BMP180_RingIndex f = filled; // only this side writes filled
+			uint8_t *block;
+
+			if ((BMP180_RingIndex)(f - BMP180_RING_LOAD(written)) == 2)
+			{
+				stats.dropped++;
+				return(0);
+			}
+			block = (uint8_t *)blocks[f & 1];
+			((uint32_t *)(block + TIME_OFFSET))[count] = time;
+			((uint32_t *)(block + UP_OFFSET))[count] = UP;
+			((uint16_t *)(block + UT_OFFSET))[count] = UT;
+			(block + OSS_OFFSET)[count] = oss;
+			count++;
+			stats.samples++;
+			if (count == BLOCK_SAMPLES)
+				handOver();
+			return(1);
+		}
+
+		char append(const BMP180_Sample &sample)
+			// as above, for a reading from SFE_BMP180::measure() or getSample()
+			// (timestamps are micros(): begin() with timeUnit 1)
+			// readings with a nonzero status are not logged
+		{
+			if (sample.status != 0)
+				return(1);
+			return(append(sample.time, sample.UT, sample.UP, sample.oss));
+		}
+
+		char service(void)
+			// write any full blocks to the sink (storage side only); call often, e.g. from loop()
+			// returns 1 for success (or nothing to write), 0 if a block write failed
+		{
+			BMP180_RingIndex w = written; // only this side writes written
+			uint32_t start, time;
+			char ok = 1;
+
+			while (w != BMP180_RING_LOAD(filled))
+			{
+				start = micros();
+				if (sink.write(blocks[w & 1], BLOCK_BYTES))
+					stats.blocks++;
+				else
+				{
+					stats.writeErrors++;
+					ok = 0;
+				}
+				time = micros() - start;
+				stats.flushLast = time;
+				if (time > stats.flushMax)
+					stats.flushMax = time;
+				stats.flushTotal += time;
+				w++;
+				BMP180_RING_STORE(written, w);
+			}
+			return(ok);
+		}
+
+		char flush(void)
+			// write out everything, including a partly filled block (zero padded), and sync the sink
+			// call only when nothing is appending, e.g. before closing the file
+			// returns 1 for success, 0 if a write or the sync failed
+		{
+			char ok;
+
+			ok = service();
+			if (count > 0)
+				handOver();
+			ok = service() && ok;
+			return(sink.sync() && ok);
+		}
+
+		uint16_t pending(void)
+			// returns the number of samples in the block being filled
+		{
+			return(count);
+		}
+
+		void getStats(BMP180_LoggerStats &copy)
+			// copy the counters (from either side)
+		{
+#ifdef __AVR__
+			uint8_t sreg = SREG; // the counters are wider than one byte
+			cli();
+#endif
+			copy = stats;
+#ifdef __AVR__
+			SREG = sreg;
+#endif
+		}
+
+		void resetStats(void)
+			// zero the counters (call when nothing is appending)
+		{
+			memset(&stats, 0, sizeof(stats));
+		}
+
+	private:
+		// Block layout, the same as BMP180_logBlockBytes()
+		enum
+		{
+			TIME_OFFSET = sizeof(BMP180_LogBlockHeader),
+			UP_OFFSET = TIME_OFFSET + (4 * BLOCK_SAMPLES),
+			UT_OFFSET = UP_OFFSET + (4 * BLOCK_SAMPLES),
+			OSS_OFFSET = UT_OFFSET + (2 * BLOCK_SAMPLES),
+			BLOCK_BYTES = (OSS_OFFSET + BLOCK_SAMPLES + 7) & ~7
+		};
+
+		void handOver(void)
+			// finish the block being filled and pass it to the storage side
+		{
+			BMP180_RingIndex f = filled;
+			uint8_t *block = (uint8_t *)blocks[f & 1];
+			BMP180_LogBlockHeader *header = (BMP180_LogBlockHeader *)block;
+			uint16_t used = count;
+
+			// Unused slots of a partly filled block are zeroed so the file contents
+			// are deterministic; a full block has none
+
+			memset(block + TIME_OFFSET + (4 * used), 0, 4 * (BLOCK_SAMPLES - used));
+			memset(block + UP_OFFSET + (4 * used), 0, 4 * (BLOCK_SAMPLES - used));
+			memset(block + UT_OFFSET + (2 * used), 0, 2 * (BLOCK_SAMPLES - used));
+			memset(block + OSS_OFFSET + used, 0, BLOCK_SAMPLES - used);
+
+			header->magic = BMP180_LOG_BLOCK_MAGIC;
+			header->count = used;
+			count = 0;
+			BMP180_RING_STORE(filled, (BMP180_RingIndex)(f + 1));
+		}
+
+		BMP180_LogSink &sink;
+		BMP180_RingIndex filled, written; // blocks handed over and blocks written, modulo the index size
+		uint16_t count; // samples in the block being filled
+		BMP180_LoggerStats stats;
+		uint32_t blocks[2][BLOCK_BYTES / 4]; // two blocks in file layout; uint32_t keeps the columns aligned
+};
+
+#endif
@@ -0,0 +1,52 @@
+/*
+	BMP180_CRC.h
+	CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF), for
+	checking data kept in EEPROM, flash or files
+
+	Plain code with no Arduino dependencies, so host-side tools compute
+	the same value (see extras/host). On AVR it uses the avr-libc
+	assembler routine for the same polynomial; elsewhere a 16-entry
+	table, four bits per step.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_CRC_h
+#define BMP180_CRC_h
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <util/crc16.h>
+#endif
+
+#define BMP180_CRC_INIT 0xFFFF
+
+inline uint16_t BMP180_crc16(const void *data, size_t length, uint16_t crc = BMP180_CRC_INIT)
+	// CRC of length bytes at data
+	// crc: BMP180_CRC_INIT for a new CRC, or the result for the previous block to continue it
+{
+	const uint8_t *p = (const uint8_t *)data;
+#ifndef __AVR__
+	static const uint16_t table[16] = {
+		0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+		0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF };
+#endif
+
+	while (length--)
+	{
+#ifdef __AVR__
+		crc = _crc_xmodem_update(crc, *p++); // same polynomial, MSB first
+#else
+		crc ^= (uint16_t)(*p++) << 8;
+		crc = (uint16_t)(crc << 4) ^ table[crc >> 12];
+		crc = (uint16_t)(crc << 4) ^ table[crc >> 12];
+#endif
+	}
+	return(crc);
+}
+
+#endif
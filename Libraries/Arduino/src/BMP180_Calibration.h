@@ -0,0 +1,25 @@
+/*
+	BMP180_Calibration.h
+	Factory calibration words of one Bosch BMP180, as read by SFE_BMP180::begin()
+
+	Plain data with no Arduino dependencies, so the same definition can be
+	shared with host-side tools (see extras/host).
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_Calibration_h
+#define BMP180_Calibration_h
+
+#include <stdint.h>
+
+struct BMP180_Calibration
+{
+	int16_t AC1,AC2,AC3;
+	uint16_t AC4,AC5,AC6;
+	int16_t VB1,VB2,MB,MC,MD;
+};
+
+#endif
@@ -0,0 +1,61 @@
+/*
+	BMP180_CalibrationStore.h
+	Somewhere to keep a BMP180's calibration between power-ups
+
+	begin() normally reads the 22 calibration bytes from the sensor and
+	works out the compensation coefficients from them. Give the driver a
+	store with setCalibrationStore() and it saves the result once, then
+	on later power-ups loads it back and only reads AC5 and AC6 (one
+	4-byte read) instead, to make sure the record is this sensor's.
+
+	The store only moves bytes; the driver checks them (version,
+	coefficient type, a CRC-16 and AC5/AC6 against the sensor, see
+	BMP180_CalibrationRecord) and reads the sensor again, replacing the
+	record, if anything is off, so swapping sensors needs no erase. To
+	keep them somewhere new, derive from BMP180_CalibrationStore and
+	implement load() and save(). Ready-made stores:
+
+		BMP180_EEPROMStore     Arduino EEPROM (BMP180_EEPROMStore.h)
+		BMP180_FileStore       a file, on a desktop (extras/host)
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_CalibrationStore_h
+#define BMP180_CalibrationStore_h
+
+#include <stdint.h>
+#include <BMP180_Calibration.h>
+
+#define BMP180_CACHE_VERSION 1 // layout of BMP180_CalibrationRecord
+
+class BMP180_CalibrationStore
+{
+	public:
+		virtual ~BMP180_CalibrationStore() {}
+
+		virtual char load(void *data, unsigned int length) = 0;
+			// copy length stored bytes into data
+			// returns 1 for success, 0 if nothing (or not that much) is stored
+
+		virtual char save(const void *data, unsigned int length) = 0;
+			// store length bytes from data, replacing what was there
+			// returns 1 for success, 0 for fail
+};
+
+template <class Real>
+struct BMP180_CalibrationRecord
+	// what the driver keeps in a store
+{
+	uint8_t version; // BMP180_CACHE_VERSION
+	uint8_t chipID; // ID register (0xD0) of the sensor it came from
+	uint8_t realSize; // sizeof(Real), the coefficient type
+	uint8_t reserved;
+	BMP180_Calibration cal; // factory calibration words
+	Real coef[13]; // c5, c6, mc, md, x0, x1, x2, y0, y1, y2, p0, p1, p2
+	uint16_t crc; // BMP180_crc16() of everything before it
+};
+
+#endif
@@ -0,0 +1,42 @@
+/*
+	BMP180_Counters.h
+	Bus and timing counters kept by a BMP180 driver instance
+
+	The counters are compiled in only when BMP180_DIAGNOSTICS is defined
+	before the driver is included:
+
+		#define BMP180_DIAGNOSTICS
+		#include <SFE_BMP180.h>
+
+	Even then counting is off until setCounters(1) is called on the driver.
+	Times are in microseconds and wrap after about 70 minutes of
+	accumulated time.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_Counters_h
+#define BMP180_Counters_h
+
+#include <stdint.h>
+
+struct BMP180_Counters
+{
+	uint32_t transactions; // I2C transactions (a register read is two: pointer write, then read)
+	uint32_t bytesWritten; // bytes sent after the address, register pointers included
+	uint32_t bytesRead; // bytes received
+	uint16_t nackAddress; // Wire status 2: no device answered its address
+	uint16_t nackData; // Wire status 3: a data byte was not acknowledged
+	uint16_t otherErrors; // any other nonzero Wire status
+	uint16_t timeouts; // reads that gave up waiting for their data (see the bus timeout)
+	uint32_t spinMicros; // spent waiting for requested bytes to arrive
+	uint32_t waitMicros; // conversion waits: from starting a conversion until its result is read
+	uint32_t samples; // pressure results timed for latency
+	uint32_t latencyMin; // end-to-end sample latency: first conversion started to pressure result read
+	uint32_t latencyAvg;
+	uint32_t latencyMax;
+};
+
+#endif
@@ -0,0 +1,1923 @@
+/*
+	BMP180_Driver.h
+	Bosch BMP180 pressure sensor driver, for any Wire-compatible I2C bus class
+	Mike Grusin, SparkFun Electronics
+
+	Uses floating-point equations from the Weather Station Data Logger project
+	http://wmrx00.sourceforge.net/
+	http://wmrx00.sourceforge.net/Arduino/BMP085-Calcs.pdf
+
+	Forked from BMP085 library by M.Grusin
+
+	version 1.0 2013/09/20 initial version
+	Verison 1.1.2 - Updated for Arduino 1.6.4 5/2015
+
+	This is the one copy of the driver. It is a template on the bus class,
+	so the bus calls are resolved at compile time and inline fully, with no
+	virtual functions. The libraries give it their usual names:
+
+		SFE_BMP180       BMP180_Driver<TwoWire> (Wire by default)
+		Teensy_BMP180    BMP180_Driver<TwoWire>, or BMP180_Driver<i2c_t3> in utilyt,
+		                 with getters that wait for the conversion
+
+	Any other class with the Wire calls used here (begin, beginTransmission,
+	write, endTransmission, requestFrom, available, read) works as well.
+
+	The second template parameter is the scalar type of the floating-point
+	compensation (the 13 coefficients and the polynomials). It defaults to
+	BMP180_real: float where the FPU is single precision only (Cortex-M4F,
+	e.g. Teensy 3.5 / 3.6), so the whole path runs in FPU instructions
+	instead of software double emulation, and double everywhere else
+	(on AVR double is float anyway). Define BMP180_COMPENSATION_DOUBLE or
+	BMP180_COMPENSATION_SINGLE before including to choose, or name the type:
+	BMP180_Driver<TwoWire,float>.
+
+	float against double on the same raw readings, every 1 deg C from -40
+	to 85 deg C and every 1 mbar from 300 to 1100 mbar, any oversampling
+	(extras/host, make precision):
+
+		temperature: largest difference 0.00001 deg C
+		pressure:    largest difference 0.0003 mbar (0.03 Pa), rms 0.00005 mbar
+
+	That is well under the sensor's 0.01 mbar resolution, so float gives up
+	nothing measurable. Integer compensation (setCompensation()) does not
+	depend on this choice.
+
+	The diagnostics (bus and timing counters, conversion time statistics
+	and the read wait histogram) cost about 150 bytes of RAM per instance
+	on AVR, so they are left out unless BMP180_DIAGNOSTICS is defined
+	before including this file. The driver is header-only, so the define
+	only has to be consistent within a sketch.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_Driver_h
+#define BMP180_Driver_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include <BMP180_Calibration.h>
+#include <BMP180_Sample.h>
+#include <BMP180_Counters.h>
+#include <BMP180_CalibrationStore.h>
+#include <BMP180_CRC.h>
+
+// Scalar type of the floating-point compensation (see above)
+#if defined(BMP180_COMPENSATION_SINGLE) || (!defined(BMP180_COMPENSATION_DOUBLE) && defined(__ARM_FP) && !(__ARM_FP & 8))
+typedef float BMP180_real;
+#else
+typedef double BMP180_real;
+#endif
+
+#define BMP180_ADDR 0x77 // 7-bit address
+
+#define	BMP180_REG_CAL 0xAA // start of 22-byte calibration EEPROM (0xAA to 0xBF)
+#define	BMP180_CAL_LENGTH 22
+#define	BMP180_REG_ID 0xD0 // chip ID, 0x55
+#define	BMP180_REG_CONTROL 0xF4
+#define	BMP180_REG_RESULT 0xF6
+
+#define	BMP180_CONTROL_SCO 0x20 // start of conversion bit: 1 while a conversion runs
+
+#define	BMP180_COMMAND_TEMPERATURE 0x2E
+#define	BMP180_COMMAND_PRESSURE0 0x34
+#define	BMP180_COMMAND_PRESSURE1 0x74
+#define	BMP180_COMMAND_PRESSURE2 0xB4
+#define	BMP180_COMMAND_PRESSURE3 0xF4
+
+#define	BMP180_TEMPERATURE_WAIT_US 4500UL // datasheet maximum temperature conversion time
+
+// Compensation engines for setCompensation()
+#define BMP180_COMPENSATION_FLOAT 0
+#define BMP180_COMPENSATION_INTEGER 1
+
+// Conversion kinds for getConversionStats() (pressure kinds are the oversampling setting)
+#define BMP180_CONVERSION_TEMPERATURE 4
+
+// poll() results
+#define BMP180_POLL_PENDING 0
+#define BMP180_POLL_READY 1
+#define BMP180_POLL_ERROR 2
+
+// Measurement cycle states
+#define BMP180_STATE_IDLE 0
+#define BMP180_STATE_TEMPERATURE 1
+#define BMP180_STATE_PRESSURE 2
+
+// Drift refresh (setTemperatureRefresh()): age of the first temperature at which
+// a second one is taken to start the trend, and the oldest a temperature may get
+// whatever the trend says (ms)
+#ifndef BMP180_DRIFT_TREND_MS
+#define BMP180_DRIFT_TREND_MS 5000UL
+#endif
+#ifndef BMP180_DRIFT_MAX_MS
+#define BMP180_DRIFT_MAX_MS 60000UL
+#endif
+
+// getError() code for a read that ran out of time (Wire uses 1 - 4)
+#define BMP180_ERROR_TIMEOUT 5
+
+// Default per-transaction bus timeout (us); 22 bytes take about 20 ms even at 10 kHz
+#define BMP180_DEFAULT_TIMEOUT 25000UL
+
+// Buckets in the read wait histogram
+#define BMP180_WAIT_BUCKETS 16
+
+// Largest read we ask of the I2C library in one transaction
+#ifndef BMP180_MAX_BURST
+#ifdef BUFFER_LENGTH
+#define BMP180_MAX_BURST BUFFER_LENGTH
+#else
+#define BMP180_MAX_BURST 32
+#endif
+#endif
+
+template <unsigned char OSS>
+struct BMP180_Oversampling
+	// everything that depends on the pressure oversampling setting, as
+	// compile-time constants for startPressure<OSS>() and getPressureInt<OSS>()
+{
+	static_assert(OSS <= 3, "OSS must be 0 - 3");
+	static const unsigned char command = BMP180_COMMAND_PRESSURE0 | (OSS << 6); // control register value
+	static const unsigned char wait = 2 + (3 << OSS); // conversion time in ms, rounded up (5, 8, 14, 26)
+	static const unsigned long waitMicros = 1500UL + (3000UL << OSS); // datasheet maximum (4.5 - 25.5 ms)
+	static const unsigned char shift = 8 - OSS; // right shift from the 24-bit result to UP
+};
+
+template <class Bus, class Real = BMP180_real>
+class BMP180_Driver
+{
+	public:
+		BMP180_Driver(Bus *bus);
+			// bus: the I2C bus the sensor is on (&Wire, &Wire1, ...)
+
+		char begin();
+			// call pressure.begin() to initialize BMP180 before use
+			// returns 1 if success, 0 if failure (bad component or I2C bus shorted?)
+
+		void setCalibrationStore(BMP180_CalibrationStore *store);
+			// keep the calibration and coefficients in store (EEPROM, a file, ...) between power-ups,
+			// so begin() loads them instead of reading the sensor's calibration (see BMP180_CalibrationStore.h)
+			// store: 0 (default) to read the sensor every time; call before begin()
+
+		char calibrationCached(void);
+			// returns 1 if the last begin() took the calibration from the store
+		
+		char startTemperature(void);
+			// command BMP180 to start a temperature measurement
+			// returns (number of ms to wait) for success, 0 for fail
+
+		char getTemperature(double &T);
+			// return temperature measurement from previous startTemperature command
+			// places returned value in T variable (deg C)
+			// returns 1 for success, 0 for fail
+
+		char startPressure(char oversampling = 3);
+			// command BMP180 to start a pressure measurement
+			// oversampling: 0 - 3 for oversampling value (default 3, highest resolution)
+			// returns (number of ms to wait) for success, 0 for fail
+
+		template <unsigned char OSS> char startPressure(void);
+			// startPressure(OSS) with the oversampling fixed at compile time, e.g. startPressure<3>()
+			// the command byte and wait are constants (see BMP180_Oversampling)
+			// returns BMP180_Oversampling<OSS>::wait for success, 0 for fail
+
+		char getPressure(double &P, double &T);
+			// return absolute pressure measurement from previous startPressure command
+			// note: requires previous temperature measurement in variable T
+			// places returned value in P variable (mbar)
+			// returns 1 for success, 0 for fail
+
+		BMP180_Sample measure(char oversampling = 3);
+			// take one complete temperature + pressure reading, blocking until it is done,
+			// with the least bus traffic (replaces the startTemperature() ... getPressure() sequence)
+			// oversampling: 0 - 3 for the pressure reading (default 3)
+			// honors setTemperatureRefresh(), setEOCPin(), setConversionPolling() and setCompensation()
+			// returns the reading with status 0, or status = getError() if it failed
+			// do not call while a startCycle() cycle is running
+
+		char setCompensation(char engine);
+			// choose the math behind getTemperature() and getPressure()
+			// engine: BMP180_COMPENSATION_FLOAT (default, floating-point polynomials) or
+			// BMP180_COMPENSATION_INTEGER (Bosch datasheet integer algorithm, no FPU needed)
+			// with the integer engine, getPressure() ignores T and uses the last temperature read
+			// returns 1 for success, 0 for unknown engine
+
+		char getTemperatureInt(int16_t &T);
+			// integer-only version of getTemperature()
+			// places returned value in T variable (0.1 deg C)
+			// returns 1 for success, 0 for fail
+
+		char getPressureInt(int32_t &P);
+			// integer-only version of getPressure()
+			// note: uses the last temperature read from the sensor, by either API
+			// places returned value in P variable (Pa)
+			// returns 1 for success, 0 for fail
+
+		template <unsigned char OSS> char getPressureInt(int32_t &P);
+			// getPressureInt() for a conversion started by startPressure<OSS>(),
+			// with the oversampling shifts of the integer algorithm fixed at compile time
+
+		void setEOCPin(int pin);
+			// use the BMP180's EOC (end of conversion) output instead of fixed worst-case delays
+			// pin: digital input connected to EOC, or -1 (default) for fixed delays
+
+		void eocInterrupt(void);
+			// call from your interrupt handler for the rising edge of EOC (optional)
+
+		char conversionReady(void);
+			// returns 1 once the last started conversion is complete
+			// (EOC high, EOC interrupt seen, or worst-case delay elapsed)
+			// use instead of delay(): while (!pressure.conversionReady()) { ... }
+
+		void setConversionPolling(unsigned int interval, unsigned char maxPolls);
+			// detect finished conversions by reading the SCO bit of the control register (no wiring needed)
+			// interval: microseconds between SCO reads, 0 (default) to turn SCO polling off
+			// maxPolls: SCO reads per conversion before falling back to the worst-case delay
+
+#ifdef BMP180_DIAGNOSTICS
+		// Diagnostics: only with BMP180_DIAGNOSTICS defined (see BMP180_Counters.h)
+
+		char getConversionStats(char kind, unsigned int &minimum, unsigned int &average, unsigned int &maximum);
+			// conversion times observed through EOC or SCO (microseconds)
+			// kind: oversampling setting 0 - 3, or BMP180_CONVERSION_TEMPERATURE
+			// returns 1 if any conversion of that kind was observed, 0 otherwise
+
+		void resetConversionStats(void);
+			// clear the observed conversion times
+
+		void setCounters(char enable);
+			// turn the bus and timing counters on (1) or off (0, default)
+			// counting costs a few micros() calls per transaction
+
+		void getCounters(BMP180_Counters &counters);
+			// copy the counters (see BMP180_Counters.h) into counters
+
+		void resetCounters(void);
+			// zero the counters
+
+		unsigned int getWaitHistogram(unsigned char bucket);
+			// how many reads waited for their data for a time in one bucket
+			// bucket 0: no wait, bucket b: 2^(b-1) to 2^b - 1 microseconds,
+			// last bucket (BMP180_WAIT_BUCKETS - 1): everything longer; counts stop at 65535
+
+		void resetWaitHistogram(void);
+			// zero the wait histogram
+#endif
+
+		void setBusTimeout(unsigned long timeout);
+			// limit how long one read transaction may wait for its data
+			// timeout: microseconds (default BMP180_DEFAULT_TIMEOUT), 0 to wait forever
+			// a read that runs out of time fails with getError() = BMP180_ERROR_TIMEOUT
+
+		char startCycle(char oversampling = 3);
+			// start a non-blocking temperature + pressure measurement cycle
+			// oversampling: 0 - 3 for oversampling value of the pressure reading (default 3)
+			// returns 1 for success, 0 for fail
+
+		char poll(void);
+			// advance the cycle started by startCycle(); returns immediately, call often
+			// returns BMP180_POLL_READY when a new sample is ready,
+			// BMP180_POLL_ERROR if the cycle failed, BMP180_POLL_PENDING otherwise
+
+		void setTemperatureRefresh(unsigned int samples, unsigned long ms, double drift);
+			// let measurement cycles reuse the stored temperature instead of measuring it every time
+			// samples: re-measure temperature after this many pressure samples (0 = no limit)
+			// ms: re-measure when the stored temperature is this old (0 = no limit)
+			// drift: re-measure when the temperature trend predicts this much change (deg C, 0 = off);
+			// also re-measures at least every BMP180_DRIFT_MAX_MS
+			// all three 0 (default): measure temperature in every cycle
+
+		char busy(void);
+			// returns 1 while a measurement cycle is in progress
+
+		char available(void);
+			// returns 1 if a new sample is waiting for getSample()
+
+		char getSample(double &T, double &P);
+			// fetch the sample from the last completed measurement cycle
+			// places temperature in T (deg C) and absolute pressure in P (mbar)
+			// returns 1 for a new sample, 0 if none was waiting
+
+		char getSample(BMP180_Sample &sample);
+			// as above, but fills a BMP180_Sample (time, T, P, raw readings, oversampling)
+			// suitable for queueing in a BMP180_RingBuffer
+			// returns 1 for a new sample, 0 if none was waiting
+
+		double sealevel(double P, double A);
+			// convert absolute pressure to sea-level pressure (as used in weather data)
+			// P: absolute pressure (mbar)
+			// A: current altitude (meters)
+			// returns sealevel pressure in mbar
+
+		double altitude(double P, double P0);
+			// convert absolute pressure to altitude (given baseline pressure; sea-level, runway, etc.)
+			// P: absolute pressure (mbar)
+			// P0: fixed baseline pressure (mbar)
+			// returns signed altitude in meters
+
+		uint16_t getRawTemperature(void);
+			// returns the raw temperature word (UT) behind the last temperature reading
+
+		uint32_t getRawPressure(void);
+			// returns the raw 24-bit pressure reading (registers 0xF6-0xF8) behind the last pressure reading
+
+		char getOversampling(void);
+			// returns the oversampling setting (0 - 3) of the last startPressure()
+
+		void getCalibration(BMP180_Calibration &cal);
+			// copy the factory calibration words read by begin() into cal
+			// (for logging, or for compensating raw readings elsewhere)
+
+		char getStartupTransactions(void);
+			// returns the number of I2C transactions the last begin() used
+			// to fetch the calibration data (1 when the Wire buffer holds all 22 bytes, or when it came from the store)
+
+		char getError(void);
+			// If any library command fails, you can retrieve an extended
+			// error code using this command. Errors are from the wire library: 
+			// 0 = Success
+			// 1 = Data too long to fit in transmit buffer
+			// 2 = Received NACK on transmit of address
+			// 3 = Received NACK on transmit of data
+			// 4 = Other error
+			// 5 = Timed out waiting for read data (BMP180_ERROR_TIMEOUT, see setBusTimeout())
+
+	private:
+	
+		char readInt(char address, int16_t &value);
+			// read an signed int (16 bits) from a BMP180 register
+			// address: BMP180 register address
+			// value: external signed int for returned value (16 bits)
+			// returns 1 for success, 0 for fail, with result in value
+
+		char readUInt(char address, uint16_t &value);
+			// read an unsigned int (16 bits) from a BMP180 register
+			// address: BMP180 register address
+			// value: external unsigned int for returned value (16 bits)
+			// returns 1 for success, 0 for fail, with result in value
+
+		char readBytes(unsigned char *values, char length, char stop = 1);
+			// read a number of bytes from a BMP180 register
+			// values: array of char with register address in first location [0]
+			// length: number of bytes to read back
+			// stop: 0 to keep the bus, so the next transaction begins with a repeated start
+			// returns 1 for success, 0 for fail, with read bytes in values[] array
+			
+		char writeBytes(unsigned char *values, char length);
+			// write a number of bytes to a BMP180 register (and consecutive subsequent registers)
+			// values: array of char with register address in first location [0]
+			// length: number of bytes to write
+			// returns 1 for success, 0 for fail
+			
+		void startConversion(char wait, char kind);
+			// remember the start time, worst-case duration (ms) and kind of a new conversion
+
+		void noteConversionTime(unsigned long elapsed);
+			// mark the conversion complete and record its observed duration (us, diagnostics only)
+
+		char waitForBytes(unsigned char length);
+			// wait (up to the bus timeout) for requested bytes, logging the wait (diagnostics only)
+			// returns 1 when they arrived, 0 with _error = BMP180_ERROR_TIMEOUT if not
+
+		void countTransaction(unsigned char written, unsigned char read);
+			// add a transaction with the Wire status in _error to the counters (no-op without diagnostics)
+
+		void noteResult(char pressure);
+			// a conversion result was read: update wait time and (pressure = 1) sample latency
+			// (no-op without diagnostics)
+
+		char temperatureDue(void);
+			// returns 1 if the next measurement cycle must re-measure temperature
+
+		void noteTemperature(void);
+			// record a fresh cycle temperature and update the temperature trend
+
+		char loadCalibration(void);
+			// fill in the calibration and coefficients from the store, if it holds a good record for this chip
+			// returns 1 if they were loaded, 0 if the sensor must be read
+
+		void saveCalibration(void);
+			// write the calibration and coefficients to the store
+
+		int32_t computeB5(void);
+			// intermediate temperature term of the integer algorithm, from the last raw temperature
+
+		char readRawPressure(void);
+			// read the pressure result into _rawUP
+			// returns 1 for success, 0 for fail
+
+		Real compensateTemperature(void);
+			// floating-point temperature (deg C) from the last raw temperature
+
+		Real compensatePressure(Real T);
+			// floating-point pressure (mbar) from the last raw pressure, at temperature T
+			// the terms that depend only on T are cached until T changes
+
+		template <unsigned char OSS> int32_t compensatePressureInt(void);
+			// integer-algorithm pressure (Pa) from the last raw pressure and temperature,
+			// with the oversampling shifts fixed at compile time
+
+		int32_t compensatePressureInt(unsigned char oversampling);
+			// as above, for an oversampling setting known only at run time
+
+		void waitConversion(unsigned long wait);
+			// block until the current conversion is complete (see conversionReady())
+
+		void waitPressure(unsigned char oversampling);
+			// waitConversion() with the datasheet maximum of a pressure conversion
+			// (BMP180_Oversampling<OSS>::waitMicros)
+			// wait: its exact worst-case duration (us), replacing the whole-ms figure
+
+		int16_t AC1,AC2,AC3,VB1,VB2,MB,MC,MD;
+		uint16_t AC4,AC5,AC6; 
+		Real c5,c6,mc,md,x0,x1,x2,y0,y1,y2,p0,p1,p2;
+		Real _cacheT, _cacheX, _cacheY; // x and y of compensatePressure() at temperature _cacheT
+		char _cacheValid;
+		char _error;
+		char _startupTransactions;
+		BMP180_CalibrationStore *_calStore;
+		char _calCached;
+		unsigned char _chipID; // 0 until read
+
+		char _compensation, _oversampling;
+		uint16_t _rawUT;
+		uint32_t _rawUP;
+
+		char _state, _cycleOversampling, _sampleReady;
+		unsigned long _convStart, _convWait;
+		int _eocPin;
+		volatile char _eocFlag;
+		char _convDone;
+		unsigned int _pollInterval;
+		unsigned char _pollMax, _polls;
+		unsigned long _lastPoll;
+		double _sampleT, _sampleP;
+		unsigned long _sampleTime;
+
+		unsigned int _refreshSamples, _samplesSinceT;
+		unsigned long _refreshMs, _lastTTime;
+		double _refreshDrift, _lastT, _tRate;
+		char _haveT, _haveTrend;
+
+		unsigned long _timeout;
+
+#ifdef BMP180_DIAGNOSTICS
+		char _convKind;
+		unsigned int _convCount[5], _convMin[5], _convMax[5]; // per kind: OSS 0 - 3, temperature
+		unsigned long _convSum[5];
+		char _countersOn, _convPending, _latencyOpen;
+		unsigned long _latencyStart;
+		uint64_t _latencySum;
+		BMP180_Counters _counters;
+		uint16_t _waitHistogram[BMP180_WAIT_BUCKETS];
+#endif
+	
+		Bus *twi;
+};
+
+
+template <class Bus, class Real>
+BMP180_Driver<Bus,Real>::BMP180_Driver(Bus *bus)
+// Set up a driver for the sensor on bus. Nothing is sent until begin().
+{
+	twi = bus;
+	_calStore = 0;
+	_calCached = 0;
+	_chipID = 0;
+	_cacheValid = 0;
+	_state = BMP180_STATE_IDLE;
+	_compensation = BMP180_COMPENSATION_FLOAT;
+	_oversampling = 0;
+	_rawUT = 0;
+	_rawUP = 0;
+	_sampleReady = 0;
+	_sampleTime = 0;
+	setTemperatureRefresh(0,0,0.0);
+	_eocPin = -1;
+	_eocFlag = 0;
+	_convStart = 0;
+	_convWait = 0;
+	_convDone = 0;
+	setConversionPolling(0,0);
+	_timeout = BMP180_DEFAULT_TIMEOUT;
+#ifdef BMP180_DIAGNOSTICS
+	_convKind = 0;
+	resetConversionStats();
+	_countersOn = 0;
+	resetCounters();
+	resetWaitHistogram();
+#endif
+}
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::begin()
+// Initialize library for subsequent pressure measurements
+{
+	double c3,c4,b1;
+	unsigned char data[BMP180_CAL_LENGTH];
+	unsigned char x, length;
+	
+	// Start up the Arduino's "wire" (I2C) library:
+	
+ 	twi->begin();
+
+	// Warm boot: the calibration may already be in the store.
+
+	_startupTransactions = 0;
+	_calCached = 0;
+	_chipID = 0;
+	_cacheValid = 0; // the coefficients are about to change
+	if (_calStore && loadCalibration())
+	{
+		_calCached = 1;
+		return(1);
+	}
+
+	// The BMP180 includes factory calibration data stored on the device.
+	// Each device has different numbers, these must be retrieved and
+	// used in the calculations when taking pressure measurements.
+
+	// Retrieve calibration data from device.
+	// The 11 words live in one contiguous block (0xAA to 0xBF), so we read
+	// it in as few transactions as the Wire buffer allows (usually just one):
+
+	for (x = 0; x < BMP180_CAL_LENGTH; x += length)
+	{
+		length = BMP180_CAL_LENGTH - x;
+		if (length > BMP180_MAX_BURST)
+			length = BMP180_MAX_BURST;
+		data[x] = BMP180_REG_CAL + x;
+		_startupTransactions++;
+		if (!readBytes(&data[x],length))
+		{
+			// Error reading calibration data; bad component or connection?
+			return(0);
+		}
+	}
+
+	// Decode the big-endian words in place:
+
+	AC1 = (int16_t)((data[0]<<8)|data[1]);
+	AC2 = (int16_t)((data[2]<<8)|data[3]);
+	AC3 = (int16_t)((data[4]<<8)|data[5]);
+	AC4 = (((uint16_t)data[6]<<8)|(uint16_t)data[7]);
+	AC5 = (((uint16_t)data[8]<<8)|(uint16_t)data[9]);
+	AC6 = (((uint16_t)data[10]<<8)|(uint16_t)data[11]);
+	VB1 = (int16_t)((data[12]<<8)|data[13]);
+	VB2 = (int16_t)((data[14]<<8)|data[15]);
+	MB = (int16_t)((data[16]<<8)|data[17]);
+	MC = (int16_t)((data[18]<<8)|data[19]);
+	MD = (int16_t)((data[20]<<8)|data[21]);
+
+	// All reads completed successfully!
+
+	// If you need to check your math using known numbers,
+	// you can uncomment one of these examples.
+	// (The correct results are commented in the below functions.)
+
+	// Example from Bosch datasheet
+	// AC1 = 408; AC2 = -72; AC3 = -14383; AC4 = 32741; AC5 = 32757; AC6 = 23153;
+	// B1 = 6190; B2 = 4; MB = -32768; MC = -8711; MD = 2868;
+
+	// Example from http://wmrx00.sourceforge.net/Arduino/BMP180-Calcs.pdf
+	// AC1 = 7911; AC2 = -934; AC3 = -14306; AC4 = 31567; AC5 = 25671; AC6 = 18974;
+	// VB1 = 5498; VB2 = 46; MB = -32768; MC = -11075; MD = 2432;
+
+	/*
+	Serial.print("AC1: "); Serial.println(AC1);
+	Serial.print("AC2: "); Serial.println(AC2);
+	Serial.print("AC3: "); Serial.println(AC3);
+	Serial.print("AC4: "); Serial.println(AC4);
+	Serial.print("AC5: "); Serial.println(AC5);
+	Serial.print("AC6: "); Serial.println(AC6);
+	Serial.print("VB1: "); Serial.println(VB1);
+	Serial.print("VB2: "); Serial.println(VB2);
+	Serial.print("MB: "); Serial.println(MB);
+	Serial.print("MC: "); Serial.println(MC);
+	Serial.print("MD: "); Serial.println(MD);
+	*/
+	
+	// Compute floating-point polynominals:
+
+	c3 = 160.0 * pow(2,-15) * AC3;
+	c4 = pow(10,-3) * pow(2,-15) * AC4;
+	b1 = pow(160,2) * pow(2,-30) * VB1;
+	c5 = (pow(2,-15) / 160) * AC5;
+	c6 = AC6;
+	mc = (pow(2,11) / pow(160,2)) * MC;
+	md = MD / 160.0;
+	x0 = AC1;
+	x1 = 160.0 * pow(2,-13) * AC2;
+	x2 = pow(160,2) * pow(2,-25) * VB2;
+	y0 = c4 * pow(2,15);
+	y1 = c4 * c3;
+	y2 = c4 * b1;
+	p0 = (3791.0 - 8.0) / 1600.0;
+	p1 = 1.0 - 7357.0 * pow(2,-20);
+	p2 = 3038.0 * 100.0 * pow(2,-36);
+
+	/*
+	Serial.println();
+	Serial.print("c3: "); Serial.println(c3);
+	Serial.print("c4: "); Serial.println(c4);
+	Serial.print("c5: "); Serial.println(c5);
+	Serial.print("c6: "); Serial.println(c6);
+	Serial.print("b1: "); Serial.println(b1);
+	Serial.print("mc: "); Serial.println(mc);
+	Serial.print("md: "); Serial.println(md);
+	Serial.print("x0: "); Serial.println(x0);
+	Serial.print("x1: "); Serial.println(x1);
+	Serial.print("x2: "); Serial.println(x2);
+	Serial.print("y0: "); Serial.println(y0);
+	Serial.print("y1: "); Serial.println(y1);
+	Serial.print("y2: "); Serial.println(y2);
+	Serial.print("p0: "); Serial.println(p0);
+	Serial.print("p1: "); Serial.println(p1);
+	Serial.print("p2: "); Serial.println(p2);
+	*/
+
+	if (_calStore)
+		saveCalibration();
+	
+	// Success!
+	return(1);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::setCalibrationStore(BMP180_CalibrationStore *store)
+// Keep the calibration in store between power-ups (0 for none).
+// begin() then loads it from there, checking the record's version,
+// coefficient type and CRC and that the sensor's AC5 and AC6 match it,
+// and reads the sensor only if the store is empty or any check fails
+// (saving the result for next time, so a swapped sensor replaces it).
+{
+	_calStore = store;
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::calibrationCached(void)
+// Returns 1 if the last begin() loaded the calibration from the store.
+{
+	return(_calCached);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::loadCalibration(void)
+// Take the calibration and coefficients from the store.
+// One bus transaction (AC5 and AC6, 4 bytes) instead of 22 bytes and the coefficient math.
+// Every chip has the same ID but its own calibration, so AC5 and AC6,
+// which vary most between parts, tell whether the record is this sensor's.
+// Returns 1 if the store held a good record for this sensor, 0 if not.
+{
+	BMP180_CalibrationRecord<Real> record;
+	unsigned char data[4];
+	Real *coef[13] = { &c5, &c6, &mc, &md, &x0, &x1, &x2, &y0, &y1, &y2, &p0, &p1, &p2 };
+	unsigned char x;
+
+	if (!_calStore->load(&record, sizeof(record)))
+		return(0);
+	if ((record.version != BMP180_CACHE_VERSION) || (record.realSize != sizeof(Real)))
+		return(0);
+
+	_startupTransactions++;
+	data[0] = BMP180_REG_CAL + 8; // AC5, AC6
+	if (!readBytes(data,4))
+		return(0);
+	if ((record.cal.AC5 != (uint16_t)((data[0]<<8)|data[1])) ||
+		(record.cal.AC6 != (uint16_t)((data[2]<<8)|data[3])))
+		return(0); // another sensor's record
+
+	if (record.crc != BMP180_crc16(&record, offsetof(BMP180_CalibrationRecord<Real>, crc)))
+		return(0);
+
+	AC1 = record.cal.AC1; AC2 = record.cal.AC2; AC3 = record.cal.AC3;
+	AC4 = record.cal.AC4; AC5 = record.cal.AC5; AC6 = record.cal.AC6;
+	VB1 = record.cal.VB1; VB2 = record.cal.VB2;
+	MB = record.cal.MB; MC = record.cal.MC; MD = record.cal.MD;
+	for (x = 0; x < 13; x++)
+		*coef[x] = record.coef[x];
+	return(1);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::saveCalibration(void)
+// Write the calibration just read, and the coefficients computed from it, to the store.
+// The chip ID goes into the record too, for anyone inspecting the store.
+{
+	BMP180_CalibrationRecord<Real> record;
+	unsigned char data[1];
+	Real *coef[13] = { &c5, &c6, &mc, &md, &x0, &x1, &x2, &y0, &y1, &y2, &p0, &p1, &p2 };
+	unsigned char x;
+
+	if (_chipID == 0)
+	{
+		data[0] = BMP180_REG_ID;
+		_startupTransactions++;
+		if (!readBytes(data,1))
+			return;
+		_chipID = data[0];
+	}
+
+	memset(&record, 0, sizeof(record)); // padding too, so the CRC is repeatable
+	record.version = BMP180_CACHE_VERSION;
+	record.chipID = _chipID;
+	record.realSize = sizeof(Real);
+	getCalibration(record.cal);
+	for (x = 0; x < 13; x++)
+		record.coef[x] = *coef[x];
+	record.crc = BMP180_crc16(&record, offsetof(BMP180_CalibrationRecord<Real>, crc));
+	_calStore->save(&record, sizeof(record));
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::readInt(char address, int16_t &value)
+// Read a signed integer (two bytes) from device
+// address: register to start reading (plus subsequent register)
+// value: external variable to store data (function modifies value)
+{
+	unsigned char data[2];
+
+	data[0] = address;
+	if (readBytes(data,2))
+	{
+		value = (int16_t)((data[0]<<8)|data[1]);
+		//if (*value & 0x8000) *value |= 0xFFFF0000; // sign extend if negative
+		return(1);
+	}
+	value = 0;
+	return(0);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::readUInt(char address, uint16_t &value)
+// Read an unsigned integer (two bytes) from device
+// address: register to start reading (plus subsequent register)
+// value: external variable to store data (function modifies value)
+{
+	unsigned char data[2];
+
+	data[0] = address;
+	if (readBytes(data,2))
+	{
+		value = (((uint16_t)data[0]<<8)|(uint16_t)data[1]);
+		return(1);
+	}
+	value = 0;
+	return(0);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::readBytes(unsigned char *values, char length, char stop)
+// Read an array of bytes from device
+// values: external array to hold data. Put starting register in values[0].
+// length: number of bytes to read
+// stop: 0 to hold the bus afterwards (the next transaction starts with a repeated start)
+{
+	uint8_t x, received;
+	char arrived;
+
+	twi->beginTransmission(BMP180_ADDR);
+	twi->write(values[0]);
+	// repeated start: keep the bus between setting the register and reading it
+	_error = twi->endTransmission(false);
+	countTransaction(1,0);
+	if (_error == 0)
+	{
+		received = twi->requestFrom(BMP180_ADDR,length,stop);
+		if (received != (uint8_t)length)
+		{
+			// nothing more will arrive: fail now instead of waiting out the timeout
+			_error = received ? 4 : 2; // short read: other error; none: NACK on address
+			countTransaction(0,received);
+			return(0);
+		}
+		arrived = waitForBytes(length); // wait until bytes are ready
+		countTransaction(0,arrived ? length : 0);
+		if (!arrived)
+			return(0);
+		for(x=0;x<length;x++)
+		{
+			values[x] = twi->read();
+		}
+		return(1);
+	}
+	return(0);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::writeBytes(unsigned char *values, char length)
+// Write an array of bytes to device
+// values: external array of data to write. Put starting register in values[0].
+// length: number of bytes to write
+{
+	twi->beginTransmission(BMP180_ADDR);
+	twi->write(values,length);
+	_error = twi->endTransmission();
+	countTransaction(length,0);
+	if (_error == 0)
+		return(1);
+	else
+		return(0);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::startTemperature(void)
+// Begin a temperature reading.
+// Will return delay in ms to wait, or 0 if I2C error
+{
+	unsigned char data[2], result;
+	
+	data[0] = BMP180_REG_CONTROL;
+	data[1] = BMP180_COMMAND_TEMPERATURE;
+	result = writeBytes(data, 2);
+	if (result) // good write?
+	{
+		startConversion(5, BMP180_CONVERSION_TEMPERATURE);
+		return(5); // return the delay in ms (rounded up) to wait before retrieving data
+	}
+	else
+		return(0); // or return 0 if there was a problem communicating with the BMP
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getTemperature(double &T)
+// Retrieve a previously-started temperature reading.
+// Requires begin() to be called once prior to retrieve calibration parameters.
+// Requires startTemperature() to have been called prior and sufficient time elapsed.
+// T: external variable to hold result.
+// Returns 1 if successful, 0 if I2C error.
+{
+	unsigned char data[2];
+	char result;
+	int16_t Ti;
+
+	if (_compensation == BMP180_COMPENSATION_INTEGER)
+	{
+		result = getTemperatureInt(Ti);
+		if (result)
+			T = Ti / 10.0;
+		return(result);
+	}
+
+	data[0] = BMP180_REG_RESULT;
+
+	result = readBytes(data, 2);
+	if (result) // good read, calculate temperature
+	{
+		_rawUT = (((uint16_t)data[0]<<8)|(uint16_t)data[1]);
+		noteResult(0);
+		T = compensateTemperature();
+	}
+	return(result);
+}
+
+
+template <class Bus, class Real>
+Real BMP180_Driver<Bus,Real>::compensateTemperature(void)
+// Temperature in deg C from the last raw reading, with the floating-point polynomials.
+{
+	Real tu, a, T;
+
+	tu = _rawUT; // (MSB * 256.0) + LSB
+
+	//example from Bosch datasheet
+	//tu = 27898;
+
+	//example from http://wmrx00.sourceforge.net/Arduino/BMP085-Calcs.pdf
+	//tu = 0x69EC;
+	
+	a = c5 * (tu - c6);
+	T = a + (mc / (a + md));
+
+	/*		
+	Serial.println();
+	Serial.print("tu: "); Serial.println(tu);
+	Serial.print("a: "); Serial.println(a);
+	Serial.print("T: "); Serial.println(T);
+	*/
+	return(T);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::startPressure(char oversampling)
+// Begin a pressure reading.
+// Oversampling: 0 to 3, higher numbers are slower, higher-res outputs.
+// Will return delay in ms to wait, or 0 if I2C error.
+{
+	switch (oversampling)
+	{
+		case 1:
+			return(startPressure<1>());
+		case 2:
+			return(startPressure<2>());
+		case 3:
+			return(startPressure<3>());
+		default: // out-of-range values use 0
+			return(startPressure<0>());
+	}
+}
+
+
+template <class Bus, class Real>
+template <unsigned char OSS>
+char BMP180_Driver<Bus,Real>::startPressure(void)
+// Begin a pressure reading with a compile-time oversampling setting.
+// Will return delay in ms to wait, or 0 if I2C error.
+{
+	unsigned char data[2];
+
+	data[0] = BMP180_REG_CONTROL;
+	data[1] = BMP180_Oversampling<OSS>::command;
+	if (writeBytes(data, 2)) // good write?
+	{
+		_oversampling = OSS; // needed to decode the result with the integer algorithm
+		startConversion(BMP180_Oversampling<OSS>::wait, OSS);
+		return(BMP180_Oversampling<OSS>::wait); // return the delay in ms (rounded up) to wait before retrieving data
+	}
+	else
+		return(0); // or return 0 if there was a problem communicating with the BMP
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getPressure(double &P, double &T)
+// Retrieve a previously started pressure reading, calculate abolute pressure in mbars.
+// Requires begin() to be called once prior to retrieve calibration parameters.
+// Requires startPressure() to have been called prior and sufficient time elapsed.
+// Requires recent temperature reading to accurately calculate pressure.
+
+// P: external variable to hold pressure.
+// T: previously-calculated temperature.
+// Returns 1 for success, 0 for I2C error.
+
+// Note that calculated pressure value is absolute mbars, to compensate for altitude call sealevel().
+{
+	char result;
+	int32_t Pi;
+
+	if (_compensation == BMP180_COMPENSATION_INTEGER)
+	{
+		result = getPressureInt(Pi);
+		if (result)
+			P = Pi / 100.0;
+		return(result);
+	}
+
+	result = readRawPressure();
+	if (result) // good read, calculate pressure
+		P = compensatePressure((Real)T);
+	return(result);
+}
+
+
+template <class Bus, class Real>
+Real BMP180_Driver<Bus,Real>::compensatePressure(Real T)
+// Pressure in mbar from the last raw reading, with the floating-point polynomials.
+// T: temperature (deg C) to compensate for.
+// Every constant is cast to Real, so a float build never touches double.
+// x and y depend only on T, which changes far less often than the pressure
+// is read (never, while setTemperatureRefresh() reuses it), so they are
+// kept until a different T comes in. That leaves a subtraction, a division
+// and the final polynomial per sample. The division by y stays: multiplying
+// by a cached 1/y would round differently and change the results.
+{
+	Real pu,s,z,P;
+
+	pu = (Real)_rawUP * (Real)(1.0 / 256.0); // exactly (MSB * 256.0) + LSB + (XLSB / 256.0)
+
+	//example from Bosch datasheet
+	//pu = 23843;
+
+	//example from http://wmrx00.sourceforge.net/Arduino/BMP085-Calcs.pdf, pu = 0x982FC0;	
+	//pu = (0x98 * 256.0) + 0x2F + (0xC0/256.0);
+	
+	if (!_cacheValid || (T != _cacheT))
+	{
+		s = T - (Real)25.0;
+		_cacheX = (x2 * (s * s)) + (x1 * s) + x0; // s * s: pow() would go through double
+		_cacheY = (y2 * (s * s)) + (y1 * s) + y0;
+		_cacheT = T;
+		_cacheValid = 1;
+	}
+	z = (pu - _cacheX) / _cacheY;
+	P = (p2 * (z * z)) + (p1 * z) + p0;
+
+	/*
+	Serial.println();
+	Serial.print("pu: "); Serial.println(pu);
+	Serial.print("T: "); Serial.println(T);
+	Serial.print("x: "); Serial.println(_cacheX);
+	Serial.print("y: "); Serial.println(_cacheY);
+	Serial.print("z: "); Serial.println(z);
+	Serial.print("P: "); Serial.println(P);
+	*/
+	return(P);
+}
+
+
+template <class Bus, class Real>
+BMP180_Sample BMP180_Driver<Bus,Real>::measure(char oversampling)
+// Take one complete temperature + pressure reading in a single call.
+// Compared with startTemperature(), delay(), getTemperature(), startPressure(),
+// delay(), getPressure(), this uses less of the bus and less time:
+// - the temperature conversion is skipped while the stored one is still good
+//   enough (see setTemperatureRefresh()),
+// - the temperature result is read and the pressure conversion started in one
+//   bus hold, with a repeated start in place of STOP + START,
+// - the temperature is compensated while the pressure conversion runs,
+// - each result is read as soon as its conversion is done: on EOC or SCO if set
+//   up, otherwise after the datasheet maximum to the microsecond, not whole ms.
+// Oversampling: 0 to 3 for the pressure reading.
+// Returns the reading; status is 0 for success, otherwise the getError() code.
+{
+	BMP180_Sample sample;
+	unsigned char data[3];
+	char fresh;
+
+	if ((unsigned char)oversampling > 3)
+		oversampling = 0;
+	memset(&sample, 0, sizeof(sample));
+	sample.oss = oversampling;
+
+	fresh = temperatureDue();
+	if (fresh)
+	{
+		if (!startTemperature())
+		{
+			sample.status = _error;
+			return(sample);
+		}
+		waitConversion(BMP180_TEMPERATURE_WAIT_US);
+		data[0] = BMP180_REG_RESULT;
+		if (!readBytes(data, 2, 0)) // hold the bus: the pressure command follows with a repeated start
+		{
+			sample.status = _error;
+			return(sample);
+		}
+		_rawUT = (((uint16_t)data[0]<<8)|(uint16_t)data[1]);
+		noteResult(0);
+	}
+
+	if (!startPressure(oversampling))
+	{
+		sample.status = _error;
+		return(sample);
+	}
+
+	if (fresh) // while the pressure converts
+	{
+		if (_compensation == BMP180_COMPENSATION_INTEGER)
+			_sampleT = (int16_t)((computeB5() + 8) >> 4) / 10.0;
+		else
+			_sampleT = compensateTemperature();
+		noteTemperature();
+	}
+
+	waitPressure(oversampling);
+	data[0] = BMP180_REG_RESULT;
+	if (!readBytes(data, 3))
+	{
+		sample.status = _error;
+		return(sample);
+	}
+	_rawUP = (((uint32_t)data[0]<<16)|((uint32_t)data[1]<<8)|(uint32_t)data[2]);
+	noteResult(1);
+	if (_samplesSinceT < 0xFFFF)
+		_samplesSinceT++;
+
+	sample.time = micros();
+	sample.T = _lastT;
+	if (_compensation == BMP180_COMPENSATION_INTEGER)
+		sample.P = compensatePressureInt(oversampling) / 100.0;
+	else
+		sample.P = compensatePressure((Real)_lastT);
+	sample.UP = _rawUP;
+	sample.UT = _rawUT;
+	return(sample);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::setCompensation(char engine)
+// Select the math used by getTemperature() and getPressure():
+// BMP180_COMPENSATION_FLOAT (default) uses the floating-point polynomials above,
+// BMP180_COMPENSATION_INTEGER uses the Bosch datasheet integer algorithm,
+// which is much cheaper on processors without an FPU.
+// Returns 1 for success, 0 for an unknown engine.
+{
+	if ((engine != BMP180_COMPENSATION_FLOAT) && (engine != BMP180_COMPENSATION_INTEGER))
+		return(0);
+	_compensation = engine;
+	return(1);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getTemperatureInt(int16_t &T)
+// Retrieve a previously-started temperature reading using integer math only.
+// Requires begin() to be called once prior to retrieve calibration parameters.
+// Requires startTemperature() to have been called prior and sufficient time elapsed.
+// T: external variable to hold result in 0.1 deg C.
+// Returns 1 if successful, 0 if I2C error.
+{
+	unsigned char data[2];
+	char result;
+
+	data[0] = BMP180_REG_RESULT;
+
+	result = readBytes(data, 2);
+	if (result) // good read, calculate temperature
+	{
+		_rawUT = (((uint16_t)data[0]<<8)|(uint16_t)data[1]);
+		noteResult(0);
+
+		//example from Bosch datasheet
+		//_rawUT = 27898; (T = 150)
+
+		T = (int16_t)((computeB5() + 8) >> 4);
+	}
+	return(result);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getPressureInt(int32_t &P)
+// Retrieve a previously started pressure reading using integer math only.
+// Requires begin() to be called once prior to retrieve calibration parameters.
+// Requires startPressure() to have been called prior and sufficient time elapsed.
+// Uses the last temperature read from the sensor (by either API) for compensation.
+// P: external variable to hold absolute pressure in Pa.
+// Returns 1 for success, 0 for I2C error.
+{
+	if (!readRawPressure())
+		return(0);
+	P = compensatePressureInt(_oversampling);
+	return(1);
+}
+
+
+template <class Bus, class Real>
+template <unsigned char OSS>
+char BMP180_Driver<Bus,Real>::getPressureInt(int32_t &P)
+// As getPressureInt(), for a conversion started by startPressure<OSS>().
+// With OSS a constant, the oversampling shifts fold at compile time.
+{
+	if (!readRawPressure())
+		return(0);
+	P = compensatePressureInt<OSS>();
+	return(1);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::readRawPressure(void)
+// Read the 24-bit pressure result into _rawUP.
+{
+	unsigned char data[3];
+
+	data[0] = BMP180_REG_RESULT;
+	if (!readBytes(data, 3))
+		return(0);
+	_rawUP = (((uint32_t)data[0]<<16)|((uint32_t)data[1]<<8)|(uint32_t)data[2]);
+	noteResult(1);
+	return(1);
+}
+
+
+template <class Bus, class Real>
+int32_t BMP180_Driver<Bus,Real>::compensatePressureInt(unsigned char oversampling)
+// Runtime oversampling: dispatch to the compile-time version.
+// oversampling: setting the raw pressure was taken with.
+{
+	switch (oversampling & 3)
+	{
+		case 0: return(compensatePressureInt<0>());
+		case 1: return(compensatePressureInt<1>());
+		case 2: return(compensatePressureInt<2>());
+		default: return(compensatePressureInt<3>());
+	}
+}
+
+
+template <class Bus, class Real>
+template <unsigned char OSS>
+int32_t BMP180_Driver<Bus,Real>::compensatePressureInt(void)
+// Pressure in Pa from the last raw pressure and temperature, with the Bosch integer algorithm.
+// OSS: setting the raw pressure was taken with; every shift by it is a constant.
+{
+	int32_t UP, B3, B5, B6, X1, X2, X3, p;
+	uint32_t B4, B7;
+
+	UP = (int32_t)(_rawUP >> BMP180_Oversampling<OSS>::shift);
+
+	//example from Bosch datasheet (with oversampling 0)
+	//UP = 23843; (P = 69964)
+
+	// Integer algorithm from the Bosch BMP180 datasheet, section 3.5:
+
+	B5 = computeB5();
+	B6 = B5 - 4000;
+	X1 = ((int32_t)VB2 * ((B6 * B6) >> 12)) >> 11;
+	X2 = ((int32_t)AC2 * B6) >> 11;
+	X3 = X1 + X2;
+	B3 = ((((int32_t)AC1 * 4 + X3) << OSS) + 2) / 4;
+	X1 = ((int32_t)AC3 * B6) >> 13;
+	X2 = ((int32_t)VB1 * ((B6 * B6) >> 12)) >> 16;
+	X3 = ((X1 + X2) + 2) >> 2;
+	B4 = ((uint32_t)AC4 * (uint32_t)(X3 + 32768)) >> 15;
+	B7 = ((uint32_t)UP - B3) * (uint32_t)(50000UL >> OSS);
+	if (B7 < 0x80000000UL)
+		p = (B7 * 2) / B4;
+	else
+		p = (B7 / B4) * 2;
+	X1 = (p >> 8) * (p >> 8);
+	X1 = (X1 * 3038) >> 16;
+	X2 = (-7357 * p) >> 16;
+	return(p + ((X1 + X2 + 3791) >> 4));
+}
+
+
+template <class Bus, class Real>
+int32_t BMP180_Driver<Bus,Real>::computeB5(void)
+// Intermediate temperature term B5 of the Bosch integer algorithm,
+// from the last raw temperature read from the sensor.
+{
+	int32_t X1, X2;
+
+	X1 = (((int32_t)_rawUT - (int32_t)AC6) * (int32_t)AC5) >> 15;
+	X2 = ((int32_t)MC << 11) / (X1 + MD);
+	return(X1 + X2);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::setEOCPin(int pin)
+// Use the BMP180's end-of-conversion output to tell when a reading is done.
+// EOC is low while a conversion runs and goes high when the result is ready,
+// usually well before the worst-case delay returned by startTemperature()/startPressure().
+// pin: digital input wired to EOC, or -1 to go back to fixed delays
+{
+	_eocPin = pin;
+	if (pin >= 0)
+		pinMode(pin, INPUT);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::eocInterrupt(void)
+// Call from an interrupt handler attached to the rising edge of EOC, e.g.
+// attachInterrupt(digitalPinToInterrupt(pin), isr, RISING) with isr() { pressure.eocInterrupt(); }
+{
+	_eocFlag = 1;
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::setConversionPolling(unsigned int interval, unsigned char maxPolls)
+// Detect the end of a conversion by reading the SCO bit (bit 5) of the control register.
+// SCO stays 1 while a conversion runs and clears when the result is ready, so
+// no extra wiring is needed. Each check costs one short I2C read.
+// interval: microseconds between SCO reads, or 0 to turn SCO polling off (default)
+// maxPolls: stop reading SCO after this many reads per conversion and wait out the worst-case delay
+{
+	_pollInterval = interval;
+	_pollMax = maxPolls;
+}
+
+
+#ifdef BMP180_DIAGNOSTICS
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getConversionStats(char kind, unsigned int &minimum, unsigned int &average, unsigned int &maximum)
+// Conversion times actually observed through EOC or SCO, in microseconds.
+// Each figure is an upper bound, good to within the polling interval.
+// kind: oversampling setting 0 to 3 for pressure, or BMP180_CONVERSION_TEMPERATURE
+// Returns 1 if at least one conversion of this kind was observed, 0 otherwise.
+{
+	if (((unsigned char)kind > BMP180_CONVERSION_TEMPERATURE) || (_convCount[(unsigned char)kind] == 0))
+		return(0);
+	minimum = _convMin[(unsigned char)kind];
+	maximum = _convMax[(unsigned char)kind];
+	average = _convSum[(unsigned char)kind] / _convCount[(unsigned char)kind];
+	return(1);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::resetConversionStats(void)
+// Forget all observed conversion times.
+{
+	unsigned char i;
+
+	for (i = 0; i <= BMP180_CONVERSION_TEMPERATURE; i++)
+	{
+		_convCount[i] = 0;
+		_convSum[i] = 0;
+		_convMin[i] = 0xFFFF;
+		_convMax[i] = 0;
+	}
+}
+#endif
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::conversionReady(void)
+// Returns 1 once the conversion started by the last startTemperature()/startPressure()
+// is complete: EOC has risen (pin or interrupt), SCO has cleared,
+// or the worst-case delay has passed.
+{
+	unsigned long now, elapsed;
+	unsigned char data[1];
+
+	if (_convDone)
+		return(1);
+
+	// micros() wraps every ~70 minutes; unsigned subtraction keeps this correct
+
+	now = micros();
+	elapsed = now - _convStart;
+
+	if (_eocFlag || ((_eocPin >= 0) && (digitalRead(_eocPin) == HIGH)))
+	{
+		noteConversionTime(elapsed);
+		return(1);
+	}
+
+	if ((_pollInterval != 0) && (_polls < _pollMax) && ((unsigned long)(now - _lastPoll) >= _pollInterval))
+	{
+		_lastPoll = now;
+		_polls++;
+		data[0] = BMP180_REG_CONTROL;
+		if (readBytes(data,1) && !(data[0] & BMP180_CONTROL_SCO))
+		{
+			noteConversionTime(micros() - _convStart);
+			return(1);
+		}
+	}
+
+	if (elapsed >= _convWait)
+	{
+		_convDone = 1;
+		return(1);
+	}
+	return(0);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::startConversion(char wait, char kind)
+// Remember when a conversion was started, its worst-case duration (ms),
+// and its kind (oversampling setting or BMP180_CONVERSION_TEMPERATURE).
+{
+	_eocFlag = 0;
+	_convDone = 0;
+	_convStart = micros();
+	_convWait = wait * 1000UL;
+	_lastPoll = _convStart;
+	_polls = 0;
+#ifdef BMP180_DIAGNOSTICS
+	_convKind = kind;
+	if (_countersOn)
+	{
+		_convPending = 1;
+		if (!_latencyOpen)
+		{
+			_latencyStart = _convStart;
+			_latencyOpen = 1;
+		}
+	}
+#else
+	(void)kind;
+#endif
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::waitConversion(unsigned long wait)
+// Block until the current conversion is complete.
+// wait: its worst-case duration in us, in place of the whole ms from startConversion().
+{
+	_convWait = wait;
+	while (!conversionReady())
+		yield();
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::waitPressure(unsigned char oversampling)
+// Block until the current pressure conversion is complete, allowing the
+// datasheet maximum for its oversampling setting to the microsecond.
+// oversampling: 0 to 3, as passed to startPressure()
+{
+	switch (oversampling)
+	{
+		case 1:
+			waitConversion(BMP180_Oversampling<1>::waitMicros);
+			break;
+		case 2:
+			waitConversion(BMP180_Oversampling<2>::waitMicros);
+			break;
+		case 3:
+			waitConversion(BMP180_Oversampling<3>::waitMicros);
+			break;
+		default:
+			waitConversion(BMP180_Oversampling<0>::waitMicros);
+			break;
+	}
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::noteConversionTime(unsigned long elapsed)
+// Mark the current conversion complete and add its observed duration (us) to the statistics.
+{
+#ifdef BMP180_DIAGNOSTICS
+	unsigned char k = _convKind;
+#endif
+
+	_convDone = 1;
+#ifdef BMP180_DIAGNOSTICS
+	if (elapsed > 0xFFFF)
+		elapsed = 0xFFFF;
+	if (_convCount[k] == 0xFFFF) // keep the average meaningful instead of wrapping
+	{
+		_convCount[k] /= 2;
+		_convSum[k] /= 2;
+	}
+	_convCount[k]++;
+	_convSum[k] += elapsed;
+	if (elapsed < _convMin[k])
+		_convMin[k] = elapsed;
+	if (elapsed > _convMax[k])
+		_convMax[k] = elapsed;
+#else
+	(void)elapsed;
+#endif
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::startCycle(char oversampling)
+// Begin a non-blocking temperature + pressure measurement cycle.
+// Oversampling: 0 to 3, used for the pressure half of the cycle (others use 0).
+// Call poll() often afterwards; it never waits.
+// Returns 1 if the temperature conversion was started, 0 if I2C error.
+{
+	char wait;
+
+	if ((unsigned char)oversampling > 3)
+		oversampling = 0; // as startPressure() does, so the sample reports what was used
+	_cycleOversampling = oversampling;
+	if (temperatureDue())
+	{
+		wait = startTemperature();
+		_state = BMP180_STATE_TEMPERATURE;
+	}
+	else
+	{
+		// The stored temperature is still good enough; go straight to pressure
+		wait = startPressure(oversampling);
+		_state = BMP180_STATE_PRESSURE;
+	}
+	if (wait == 0)
+	{
+		_state = BMP180_STATE_IDLE;
+		return(0);
+	}
+	return(1);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::poll(void)
+// Advance the measurement cycle started by startCycle() without blocking.
+// Reads a conversion only once it is complete (see conversionReady()), then starts the next one.
+// Returns BMP180_POLL_READY when a new sample became ready during this call,
+// BMP180_POLL_ERROR if the cycle was aborted by an I2C error (see getError()),
+// or BMP180_POLL_PENDING otherwise.
+{
+	char wait;
+
+	if (_state == BMP180_STATE_IDLE)
+		return(BMP180_POLL_PENDING);
+
+	if (!conversionReady())
+		return(BMP180_POLL_PENDING);
+
+	if (_state == BMP180_STATE_TEMPERATURE)
+	{
+		if (getTemperature(_sampleT) && ((wait = startPressure(_cycleOversampling)) != 0))
+		{
+			noteTemperature();
+			_state = BMP180_STATE_PRESSURE;
+			return(BMP180_POLL_PENDING);
+		}
+	}
+	else // BMP180_STATE_PRESSURE
+	{
+		if (getPressure(_sampleP,_sampleT))
+		{
+			_state = BMP180_STATE_IDLE;
+			_sampleReady = 1;
+			_sampleTime = micros();
+			if (_samplesSinceT < 0xFFFF)
+				_samplesSinceT++;
+			return(BMP180_POLL_READY);
+		}
+	}
+	_state = BMP180_STATE_IDLE;
+	return(BMP180_POLL_ERROR);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::setTemperatureRefresh(unsigned int samples, unsigned long ms, double drift)
+// Choose when a measurement cycle re-measures temperature.
+// Temperature changes slowly, and one reading can serve many pressure readings,
+// so skipping it raises the pressure sample rate (nearly 2x at oversampling 0).
+// samples: re-measure after this many pressure samples (0 = no limit)
+// ms: re-measure once the stored temperature is this old (0 = no limit)
+// drift: re-measure once the temperature trend predicts this much change (deg C, 0 = off)
+// The trend needs two readings, so the second comes BMP180_DRIFT_TREND_MS after the
+// first; a flat trend predicts no change, so drift mode also re-measures once the
+// stored temperature is BMP180_DRIFT_MAX_MS old.
+// With all three 0 (the default) every cycle measures temperature.
+{
+	_refreshSamples = samples;
+	_refreshMs = ms;
+	_refreshDrift = drift;
+	_haveT = 0;
+	_haveTrend = 0;
+}
+
+
+#ifdef BMP180_DIAGNOSTICS
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::setCounters(char enable)
+// Turn the bus and timing counters on or off. Counts are kept while off.
+// enable: 1 to count, 0 (default) to stop
+{
+	_countersOn = enable;
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::getCounters(BMP180_Counters &counters)
+// Copy the counters; latencyAvg is worked out here from the running sum.
+// counters: external structure to fill
+{
+	counters = _counters;
+	counters.latencyAvg = _counters.samples ? (uint32_t)(_latencySum / _counters.samples) : 0;
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::resetCounters(void)
+// Zero the counters and forget any conversion or sample being timed.
+{
+	memset(&_counters, 0, sizeof(_counters));
+	_latencySum = 0;
+	_convPending = 0;
+	_latencyOpen = 0;
+}
+
+
+template <class Bus, class Real>
+unsigned int BMP180_Driver<Bus,Real>::getWaitHistogram(unsigned char bucket)
+// Returns the number of reads whose wait fell in bucket (see the header), 0 for a bad bucket.
+{
+	if (bucket >= BMP180_WAIT_BUCKETS)
+		return(0);
+	return(_waitHistogram[bucket]);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::resetWaitHistogram(void)
+{
+	memset(_waitHistogram, 0, sizeof(_waitHistogram));
+}
+#endif
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::setBusTimeout(unsigned long timeout)
+// Limit how long a read transaction waits for its data to arrive.
+// On AVR and most cores requestFrom() itself blocks until the transfer ends,
+// so the wait is normally zero; non-blocking I2C libraries and glitched
+// buses are what this guards against.
+// timeout: microseconds, 0 to wait forever
+{
+	_timeout = timeout;
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::waitForBytes(unsigned char length)
+// Wait until the requested bytes are available, for at most _timeout us.
+// With diagnostics the wait goes into the histogram (and spinMicros when counting).
+// Returns 1 when the bytes arrived, 0 with _error = BMP180_ERROR_TIMEOUT otherwise.
+{
+	unsigned long start, waited;
+#ifdef BMP180_DIAGNOSTICS
+	unsigned long scaled;
+	unsigned char bucket;
+#endif
+	char arrived;
+
+	waited = 0;
+	arrived = 1;
+	// the usual case, with nothing to time
+	if (twi->available() < length)
+	{
+		start = micros();
+		while (twi->available() < length)
+		{
+			waited = micros() - start;
+			if ((_timeout != 0) && (waited >= _timeout))
+			{
+				_error = BMP180_ERROR_TIMEOUT;
+				arrived = 0;
+				break;
+			}
+		}
+#ifdef BMP180_DIAGNOSTICS
+		if (arrived)
+			waited = micros() - start;
+#endif
+	}
+
+#ifdef BMP180_DIAGNOSTICS
+	// bucket b holds waits of 2^(b-1) to 2^b - 1 us
+	scaled = waited;
+	for (bucket = 0; (scaled != 0) && (bucket < BMP180_WAIT_BUCKETS - 1); bucket++)
+		scaled >>= 1;
+	if (_waitHistogram[bucket] < 0xFFFF)
+		_waitHistogram[bucket]++;
+	if (_countersOn)
+		_counters.spinMicros += waited;
+#endif
+	return(arrived);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::countTransaction(unsigned char written, unsigned char read)
+// Add one transaction to the counters, sorting a failure by its Wire status (_error).
+{
+#ifdef BMP180_DIAGNOSTICS
+	if (!_countersOn)
+		return;
+	_counters.transactions++;
+	_counters.bytesWritten += written;
+	_counters.bytesRead += read;
+	if (_error == 2)
+		_counters.nackAddress++;
+	else if (_error == 3)
+		_counters.nackData++;
+	else if (_error == BMP180_ERROR_TIMEOUT)
+		_counters.timeouts++;
+	else if (_error != 0)
+		_counters.otherErrors++;
+#else
+	(void)written;
+	(void)read;
+#endif
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::noteResult(char pressure)
+// A conversion result was just read. Close the wait that started with the
+// conversion and, for a pressure result, the sample that started with its
+// first conversion (the temperature, unless temperature is being reused).
+// pressure: 1 for a pressure result, 0 for temperature
+{
+#ifdef BMP180_DIAGNOSTICS
+	unsigned long now, latency;
+
+	if (!_countersOn)
+		return;
+	now = micros();
+	if (_convPending)
+	{
+		_counters.waitMicros += now - _convStart;
+		_convPending = 0;
+	}
+	if (pressure && _latencyOpen)
+	{
+		latency = now - _latencyStart;
+		_latencyOpen = 0;
+		if ((_counters.samples == 0) || (latency < _counters.latencyMin))
+			_counters.latencyMin = latency;
+		if (latency > _counters.latencyMax)
+			_counters.latencyMax = latency;
+		_latencySum += latency;
+		_counters.samples++;
+	}
+#else
+	(void)pressure;
+#endif
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::temperatureDue(void)
+// Returns 1 if the next measurement cycle must re-measure temperature.
+{
+	unsigned long age;
+	double drift;
+
+	if (!_haveT || ((_refreshSamples == 0) && (_refreshMs == 0) && (_refreshDrift <= 0.0)))
+		return(1);
+	if ((_refreshSamples != 0) && (_samplesSinceT >= _refreshSamples))
+		return(1);
+	age = millis() - _lastTTime;
+	if ((_refreshMs != 0) && (age >= _refreshMs))
+		return(1);
+	if (_refreshDrift > 0.0)
+	{
+		if (age >= (_haveTrend ? BMP180_DRIFT_MAX_MS : BMP180_DRIFT_TREND_MS))
+			return(1);
+		drift = _tRate * age;
+		if ((drift >= _refreshDrift) || (-drift >= _refreshDrift))
+			return(1);
+	}
+	return(0);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::noteTemperature(void)
+// Record a fresh cycle temperature (_sampleT) and update the temperature trend.
+{
+	unsigned long now, elapsed;
+
+	now = millis();
+	elapsed = now - _lastTTime;
+	if (_haveT && (elapsed > 0))
+	{
+		_tRate = (_sampleT - _lastT) / elapsed;
+		_haveTrend = 1;
+	}
+	else
+	{
+		_tRate = 0.0;
+		_haveTrend = 0;
+	}
+	_lastT = _sampleT;
+	_lastTTime = now;
+	_samplesSinceT = 0;
+	_haveT = 1;
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::busy(void)
+// Returns 1 while a measurement cycle is in progress, 0 otherwise.
+{
+	return(_state != BMP180_STATE_IDLE);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::available(void)
+// Returns 1 if a completed sample is waiting to be fetched with getSample().
+{
+	return(_sampleReady);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getSample(double &T, double &P)
+// Fetch the sample completed by the last measurement cycle.
+// T: external variable to hold temperature (deg C).
+// P: external variable to hold absolute pressure (mbar).
+// Returns 1 if a new sample was waiting, 0 if not (T and P untouched).
+{
+	if (!_sampleReady)
+		return(0);
+	T = _sampleT;
+	P = _sampleP;
+	_sampleReady = 0;
+	return(1);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getSample(BMP180_Sample &sample)
+// Fetch the sample completed by the last measurement cycle, with its
+// completion time (micros()) and the raw readings behind it.
+// sample: external structure to fill.
+// Returns 1 if a new sample was waiting, 0 if not (sample untouched).
+{
+	if (!_sampleReady)
+		return(0);
+	sample.time = _sampleTime;
+	sample.T = _sampleT;
+	sample.P = _sampleP;
+	sample.UP = _rawUP;
+	sample.UT = _rawUT;
+	sample.oss = _cycleOversampling;
+	sample.status = 0;
+	_sampleReady = 0;
+	return(1);
+}
+
+
+template <class Bus, class Real>
+double BMP180_Driver<Bus,Real>::sealevel(double P, double A)
+// Given a pressure P (mb) taken at a specific altitude (meters),
+// return the equivalent pressure (mb) at sea level.
+// This produces pressure readings that can be used for weather measurements.
+{
+	return(P/pow(1-(A/44330.0),5.255));
+}
+
+
+template <class Bus, class Real>
+double BMP180_Driver<Bus,Real>::altitude(double P, double P0)
+// Given a pressure measurement P (mb) and the pressure at a baseline P0 (mb),
+// return altitude (meters) above baseline.
+{
+	return(44330.0*(1-pow(P/P0,1/5.255)));
+}
+
+
+template <class Bus, class Real>
+uint16_t BMP180_Driver<Bus,Real>::getRawTemperature(void)
+// Raw temperature word from the last temperature reading.
+{
+	return(_rawUT);
+}
+
+
+template <class Bus, class Real>
+uint32_t BMP180_Driver<Bus,Real>::getRawPressure(void)
+// Raw 24-bit pressure reading (0xF6-0xF8) from the last pressure reading.
+{
+	return(_rawUP);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getOversampling(void)
+// Oversampling setting of the last startPressure() command.
+{
+	return(_oversampling);
+}
+
+
+template <class Bus, class Real>
+void BMP180_Driver<Bus,Real>::getCalibration(BMP180_Calibration &cal)
+// Copy the calibration words read by begin().
+{
+	cal.AC1 = AC1; cal.AC2 = AC2; cal.AC3 = AC3;
+	cal.AC4 = AC4; cal.AC5 = AC5; cal.AC6 = AC6;
+	cal.VB1 = VB1; cal.VB2 = VB2;
+	cal.MB = MB; cal.MC = MC; cal.MD = MD;
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getStartupTransactions(void)
+// Number of I2C transactions the last begin() needed to fetch calibration data.
+{
+	return(_startupTransactions);
+}
+
+
+template <class Bus, class Real>
+char BMP180_Driver<Bus,Real>::getError(void)
+	// If any library command fails, you can retrieve an extended
+	// error code using this command. Errors are from the wire library: 
+	// 0 = Success
+	// 1 = Data too long to fit in transmit buffer
+	// 2 = Received NACK on transmit of address
+	// 3 = Received NACK on transmit of data
+	// 4 = Other error
+{
+	return(_error);
+}
+
+#endif
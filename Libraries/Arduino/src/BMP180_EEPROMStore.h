@@ -0,0 +1,63 @@
+/*
+	BMP180_EEPROMStore.h
+	Calibration store in the microcontroller's EEPROM
+
+		#include <SFE_BMP180.h>
+		#include <BMP180_EEPROMStore.h>
+
+		SFE_BMP180 pressure;
+		BMP180_EEPROMStore store(0); // EEPROM address to use
+
+		pressure.setCalibrationStore(&store);
+		pressure.begin();
+
+	The record takes sizeof(BMP180_CalibrationRecord<BMP180_real>) bytes:
+	80 on AVR, 84 on Teensy 3.5 / 3.6 (float), 144 elsewhere. Bytes are only written when they
+	change (EEPROM.update()), so a cache that is already there costs no
+	EEPROM wear. Needs an EEPROM library with read(), update() and
+	length(), as on AVR boards and Teensy.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_EEPROMStore_h
+#define BMP180_EEPROMStore_h
+
+#include <EEPROM.h>
+#include <BMP180_CalibrationStore.h>
+
+class BMP180_EEPROMStore : public BMP180_CalibrationStore
+{
+	public:
+		BMP180_EEPROMStore(unsigned int address = 0) : address(address) {}
+			// address: first EEPROM byte to use
+
+		char load(void *data, unsigned int length)
+		{
+			unsigned int i;
+
+			if (address + length > EEPROM.length())
+				return(0);
+			for (i = 0; i < length; i++)
+				((uint8_t *)data)[i] = EEPROM.read(address + i);
+			return(1);
+		}
+
+		char save(const void *data, unsigned int length)
+		{
+			unsigned int i;
+
+			if (address + length > EEPROM.length())
+				return(0);
+			for (i = 0; i < length; i++)
+				EEPROM.update(address + i, ((const uint8_t *)data)[i]);
+			return(1);
+		}
+
+	private:
+		unsigned int address;
+};
+
+#endif
@@ -0,0 +1,255 @@
+/*
+	BMP180_Filter.h
+	Streaming filters for compensated BMP180 pressure (or temperature)
+
+	Hardware oversampling stops at OSS 3 (26 ms). Averaging many fast OSS 0
+	readings (5 ms each) in software gives finer resolution and a free
+	choice of rate versus noise. All filters here use fixed memory, no heap,
+	and a constant amount of work per sample.
+
+	BMP180_MedianFilter<N>     median of the last N samples (spike rejection)
+	BMP180_MovingAverage<N>    mean of the last N samples (noise / N^0.5)
+	BMP180_ExpFilter           exponential (single-pole IIR) smoothing
+	BMP180_FilterBank<M,N>     median -> moving average -> exponential, in one call
+
+	Example:
+
+		BMP180_FilterBank<3,16> filter; // 3-sample median, 16-sample average
+		filter.setSmoothing(0.0);        // exponential stage off
+		...
+		if (pressure.getPressure(P,T))
+			Pfiltered = filter.update(P);
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_Filter_h
+#define BMP180_Filter_h
+
+#include <math.h>
+
+template <unsigned char N>
+class BMP180_MovingAverage
+{
+	static_assert(N >= 1, "N must be at least 1");
+
+	public:
+		BMP180_MovingAverage() { reset(); }
+
+		void reset(void)
+			// forget all samples
+		{
+			sum = 0.0;
+			fresh = 0.0;
+			next = 0;
+			filled = 0;
+		}
+
+		double update(double x)
+			// add a sample, returns the mean of the last N (fewer until the window fills)
+		{
+			if (filled == N)
+				sum -= window[next];
+			else
+				filled++;
+			window[next] = x;
+			sum += x;
+			fresh += x;
+			if (++next == N)
+			{
+				// fresh now holds exactly the current window; swapping it in
+				// stops rounding error building up in the running sum
+				next = 0;
+				sum = fresh;
+				fresh = 0.0;
+			}
+			return(sum / filled);
+		}
+
+		double value(void)
+			// mean of the samples in the window (0 if none)
+		{
+			return(filled ? sum / filled : 0.0);
+		}
+
+		char ready(void)
+			// returns 1 once the window holds N samples
+		{
+			return(filled == N);
+		}
+
+	private:
+		double window[N];
+		double sum, fresh;
+		unsigned char next, filled;
+};
+
+
+template <unsigned char N>
+class BMP180_MedianFilter
+{
+	static_assert((N >= 1) && (N & 1), "N must be odd");
+
+	public:
+		BMP180_MedianFilter() { reset(); }
+
+		void reset(void)
+			// forget all samples
+		{
+			next = 0;
+			filled = 0;
+		}
+
+		double update(double x)
+			// add a sample, returns the median of the last N (fewer until the window fills)
+			// NaN and infinity (a failed reading) are ignored and the median returned unchanged;
+			// the oldest sample is found by value, which never matches a NaN
+		{
+			unsigned char i;
+			double old;
+
+			if (!isfinite(x))
+				return(value());
+			if (filled == N)
+			{
+				// remove the oldest sample from the sorted copy
+				old = window[next];
+				for (i = 0; (i < N - 1) && (sorted[i] != old); i++)
+					;
+				for (; i < N - 1; i++)
+					sorted[i] = sorted[i + 1];
+				filled--;
+			}
+			window[next] = x;
+			if (++next == N)
+				next = 0;
+
+			// insert the new one
+			for (i = filled; (i > 0) && (sorted[i - 1] > x); i--)
+				sorted[i] = sorted[i - 1];
+			sorted[i] = x;
+			filled++;
+
+			return(sorted[(filled - 1) / 2]);
+		}
+
+		double value(void)
+			// median of the samples in the window (0 if none)
+		{
+			return(filled ? sorted[(filled - 1) / 2] : 0.0);
+		}
+
+		char ready(void)
+			// returns 1 once the window holds N samples
+		{
+			return(filled == N);
+		}
+
+	private:
+		double window[N]; // arrival order
+		double sorted[N]; // same samples, ascending
+		unsigned char next, filled;
+};
+
+
+class BMP180_ExpFilter
+{
+	public:
+		BMP180_ExpFilter(double alpha = 0.0) { setSmoothing(alpha); }
+
+		void setSmoothing(double alpha)
+			// alpha: weight of each new sample, 0 < alpha <= 1 (smaller = smoother)
+			// 0 (or anything outside that range) turns the filter off (output = input)
+			// alpha = 2 / (N + 1) matches the noise reduction of an N-sample moving average
+		{
+			this->alpha = ((alpha > 0.0) && (alpha <= 1.0)) ? alpha : 1.0;
+			reset();
+		}
+
+		void reset(void)
+			// forget the filter state; the next sample is passed through unchanged
+		{
+			primed = 0;
+			y = 0.0;
+		}
+
+		double update(double x)
+			// add a sample, returns the filtered value
+		{
+			if (!primed)
+			{
+				y = x;
+				primed = 1;
+			}
+			else
+				y += alpha * (x - y);
+			return(y);
+		}
+
+		double value(void)
+			// last filtered value (0 if none)
+		{
+			return(y);
+		}
+
+	private:
+		double alpha, y;
+		char primed;
+};
+
+
+template <unsigned char MEDIAN, unsigned char AVERAGE>
+class BMP180_FilterBank
+	// MEDIAN or AVERAGE = 1 skips that stage
+{
+	public:
+		BMP180_FilterBank(double alpha = 0.0) : smooth(alpha) {}
+
+		void setSmoothing(double alpha)
+			// exponential stage weight, see BMP180_ExpFilter::setSmoothing() (0 = off)
+		{
+			smooth.setSmoothing(alpha);
+		}
+
+		void reset(void)
+			// forget all samples in every stage
+		{
+			median.reset();
+			average.reset();
+			smooth.reset();
+		}
+
+		double update(double x)
+			// add a sample, returns the output of the last stage
+			// NaN and infinity are ignored by every stage, as by BMP180_MedianFilter
+		{
+			if (!isfinite(x))
+				return(value());
+			if (MEDIAN > 1)
+				x = median.update(x);
+			if (AVERAGE > 1)
+				x = average.update(x);
+			return(smooth.update(x));
+		}
+
+		double value(void)
+			// last output
+		{
+			return(smooth.value());
+		}
+
+		char ready(void)
+			// returns 1 once the median and average windows are full
+		{
+			return(((MEDIAN <= 1) || median.ready()) && ((AVERAGE <= 1) || average.ready()));
+		}
+
+	private:
+		BMP180_MedianFilter<MEDIAN> median;
+		BMP180_MovingAverage<AVERAGE> average;
+		BMP180_ExpFilter smooth;
+};
+
+#endif
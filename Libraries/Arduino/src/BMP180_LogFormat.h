@@ -0,0 +1,65 @@
+/*
+	BMP180_LogFormat.h
+	Columnar raw-sample log format for the Bosch BMP180
+
+	A log stores raw readings plus the calibration needed to compensate
+	them later, in a layout that can be memory-mapped and read in place:
+
+	  file header    64 bytes, see BMP180_LogHeader
+	  block 0        BMP180_logBlockBytes(blockSamples) bytes
+	  block 1        ...
+
+	Each block holds up to blockSamples samples as fixed-width columns:
+
+	  BMP180_LogBlockHeader   8 bytes (magic, sample count)
+	  uint32_t time[blockSamples]   timestamp, in units of timeUnit microseconds
+	  uint32_t UP[blockSamples]     raw 24-bit pressure reading (0xF6-0xF8)
+	  uint16_t UT[blockSamples]     raw temperature word
+	  uint8_t  oss[blockSamples]    oversampling setting of the pressure reading
+	  padding to a multiple of 8 bytes
+
+	Every block has the same size, even when the last one is partly
+	filled, so block n starts at 64 + n * BMP180_logBlockBytes(blockSamples).
+	Columns are ordered widest first and every block starts on an 8-byte
+	boundary, so each column is naturally aligned in a mapped file.
+	All fields are little-endian (the byte order of every Arduino target).
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_LogFormat_h
+#define BMP180_LogFormat_h
+
+#include <stdint.h>
+#include <BMP180_Calibration.h>
+
+#define BMP180_LOG_MAGIC "BMP180LG" // first 8 bytes of a log file
+#define BMP180_LOG_VERSION 1
+#define BMP180_LOG_HEADER_BYTES 64
+#define BMP180_LOG_BLOCK_MAGIC 0x4B4C4231UL // "1BLK" in file byte order
+
+struct BMP180_LogHeader
+{
+	char magic[8]; // BMP180_LOG_MAGIC, not NUL-terminated
+	uint16_t version; // BMP180_LOG_VERSION
+	uint16_t blockSamples; // samples per block
+	uint32_t timeUnit; // microseconds per timestamp tick (1000 for millis(), 1 for micros())
+	BMP180_Calibration cal; // calibration words of the logged sensor (22 bytes)
+	uint8_t reserved[BMP180_LOG_HEADER_BYTES - 16 - sizeof(BMP180_Calibration)]; // zero
+};
+
+struct BMP180_LogBlockHeader
+{
+	uint32_t magic; // BMP180_LOG_BLOCK_MAGIC
+	uint32_t count; // samples used in this block (1 to blockSamples)
+};
+
+inline uint32_t BMP180_logBlockBytes(uint32_t blockSamples)
+// Size of one block, including its header and padding
+{
+	return((sizeof(BMP180_LogBlockHeader) + blockSamples * (4 + 4 + 2 + 1) + 7) & ~(uint32_t)7);
+}
+
+#endif
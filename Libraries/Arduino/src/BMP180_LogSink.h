@@ -0,0 +1,42 @@
+/*
+	BMP180_LogSink.h
+	Somewhere for BMP180_BlockLogger to put finished blocks
+
+	The logger hands the sink one whole block at a time from
+	BMP180_BlockLogger::service(), never from the sampling side, so a
+	sink may take as long as its storage needs (an SD card can stall for
+	100 ms or more on a sector write). To log somewhere new, derive from
+	BMP180_LogSink and implement write(). Ready-made sinks:
+
+		BMP180_PrintSink     any Arduino Print: SD or SdFat File, Serial (BMP180_PrintSink.h)
+		BMP180_FileSink      a file, on a desktop or Linux board (extras/host)
+
+	For raw SPI flash, write() would program the block at the next free
+	address and sync() would do nothing.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_LogSink_h
+#define BMP180_LogSink_h
+
+#include <stdint.h>
+
+class BMP180_LogSink
+{
+	public:
+		virtual char write(const void *data, unsigned int length) = 0;
+			// store length bytes after the ones written before
+			// returns 1 for success, 0 for fail
+
+		virtual char sync(void)
+			// make everything written so far durable (flush caches, update the directory entry)
+			// returns 1 for success, 0 for fail
+		{
+			return(1);
+		}
+};
+
+#endif
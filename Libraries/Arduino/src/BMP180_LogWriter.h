@@ -0,0 +1,136 @@
+/*
+	BMP180_LogWriter.h
+	Block writer for the columnar BMP180 log format (see BMP180_LogFormat.h)
+
+	Samples are collected into one block in RAM and written out in a single
+	call when the block fills, which suits SD cards and flash far better
+	than printing each reading as text. The output is any Arduino Print
+	(an SD File, Serial, ...).
+
+	The block is kept in RAM in its file layout, so RAM use is
+	BMP180_logBlockBytes(BLOCK_SAMPLES), about 11 bytes per sample of block
+	capacity; 32 samples (360 bytes) is a sensible size on an Uno, 512 on
+	a Teensy.
+
+	append() writes the block out itself when it fills, so that reading
+	waits for the storage. BMP180_BlockLogger (BMP180_BlockLogger.h)
+	writes the same format without making the sampling side wait.
+
+	Example:
+
+		BMP180_LogWriter<32> log(file);
+		BMP180_Calibration cal;
+		pressure.getCalibration(cal);
+		log.begin(cal, 1000); // timestamps from millis()
+		...
+		log.append(millis(), pressure.getRawTemperature(), pressure.getRawPressure(), pressure.getOversampling());
+		...
+		log.flush(); // before closing the file
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_LogWriter_h
+#define BMP180_LogWriter_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <BMP180_LogFormat.h>
+
+template <uint16_t BLOCK_SAMPLES>
+class BMP180_LogWriter
+{
+	public:
+		BMP180_LogWriter(Print &output) : out(output), count(0)
+		{
+			memset(block, 0, sizeof(block));
+		}
+
+		char begin(const BMP180_Calibration &cal, uint32_t timeUnit)
+			// write the file header
+			// cal: calibration words of the logged sensor (SFE_BMP180::getCalibration())
+			// timeUnit: microseconds per timestamp tick (1000 for millis(), 1 for micros())
+			// returns 1 for success, 0 if the output did not take the whole header
+		{
+			BMP180_LogHeader header;
+
+			memset(&header, 0, sizeof(header));
+			memcpy(header.magic, BMP180_LOG_MAGIC, sizeof(header.magic));
+			header.version = BMP180_LOG_VERSION;
+			header.blockSamples = BLOCK_SAMPLES;
+			header.timeUnit = timeUnit;
+			header.cal = cal;
+			count = 0;
+			return(out.write((const uint8_t *)&header, sizeof(header)) == sizeof(header));
+		}
+
+		char append(uint32_t time, uint16_t UT, uint32_t UP, uint8_t oss)
+			// add one raw sample; writes the block out when it fills
+			// returns 1 for success, 0 if a block write failed
+		{
+			uint8_t *bytes = (uint8_t *)block;
+
+			((uint32_t *)(bytes + TIME_OFFSET))[count] = time;
+			((uint32_t *)(bytes + UP_OFFSET))[count] = UP;
+			((uint16_t *)(bytes + UT_OFFSET))[count] = UT;
+			(bytes + OSS_OFFSET)[count] = oss;
+			count++;
+			if (count == BLOCK_SAMPLES)
+				return(flush());
+			return(1);
+		}
+
+		char flush(void)
+			// write out a partly filled block (the rest of it is zero padding)
+			// returns 1 for success (or nothing to write), 0 if the write failed
+		{
+			uint8_t *bytes = (uint8_t *)block;
+			BMP180_LogBlockHeader *header = (BMP180_LogBlockHeader *)bytes;
+			uint16_t used;
+
+			if (count == 0)
+				return(1);
+			used = count;
+			count = 0;
+
+			// Unused slots are zeroed so the file contents are deterministic
+
+			memset(bytes + TIME_OFFSET + (4 * used), 0, 4 * (BLOCK_SAMPLES - used));
+			memset(bytes + UP_OFFSET + (4 * used), 0, 4 * (BLOCK_SAMPLES - used));
+			memset(bytes + UT_OFFSET + (2 * used), 0, 2 * (BLOCK_SAMPLES - used));
+			memset(bytes + OSS_OFFSET + used, 0, BLOCK_SAMPLES - used);
+
+			header->magic = BMP180_LOG_BLOCK_MAGIC;
+			header->count = used;
+			return(out.write(bytes, BLOCK_BYTES) == BLOCK_BYTES);
+		}
+
+		uint16_t pending(void)
+			// returns the number of samples waiting in the current block
+		{
+			return(count);
+		}
+
+	private:
+		// Block layout, the same as BMP180_logBlockBytes()
+		enum
+		{
+			TIME_OFFSET = sizeof(BMP180_LogBlockHeader),
+			UP_OFFSET = TIME_OFFSET + (4 * BLOCK_SAMPLES),
+			UT_OFFSET = UP_OFFSET + (4 * BLOCK_SAMPLES),
+			OSS_OFFSET = UT_OFFSET + (2 * BLOCK_SAMPLES),
+			BLOCK_BYTES = (OSS_OFFSET + BLOCK_SAMPLES + 7) & ~7
+		};
+
+		Print &out;
+		uint16_t count;
+		uint32_t block[BLOCK_BYTES / 4]; // the block in file layout; uint32_t keeps the columns aligned
+};
+
+#endif
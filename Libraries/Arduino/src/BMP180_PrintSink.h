@@ -0,0 +1,53 @@
+/*
+	BMP180_PrintSink.h
+	Log sink that writes to any Arduino Print
+
+		#include <SD.h>
+		#include <BMP180_BlockLogger.h>
+		#include <BMP180_PrintSink.h>
+
+		File file = SD.open("log.bmp", FILE_WRITE);
+		BMP180_PrintSink sink(file);
+		BMP180_BlockLogger<22> logger(sink);
+
+	Works with SD and SdFat files, and with Serial for a quick look at the
+	raw bytes. sync() calls the output's flush(), which on a file writes
+	out the cached sector and updates the directory entry.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_PrintSink_h
+#define BMP180_PrintSink_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <BMP180_LogSink.h>
+
+class BMP180_PrintSink : public BMP180_LogSink
+{
+	public:
+		BMP180_PrintSink(Print &output) : out(output) {}
+
+		char write(const void *data, unsigned int length)
+		{
+			return(out.write((const uint8_t *)data, length) == length);
+		}
+
+		char sync(void)
+		{
+			out.flush();
+			return(1);
+		}
+
+	private:
+		Print &out;
+};
+
+#endif
@@ -0,0 +1,115 @@
+/*
+	BMP180_RingBuffer.h
+	Lock-free single-producer / single-consumer ring buffer
+
+	Lets one context fill a queue (a timer interrupt, a sampling task, one
+	core) while another drains it (loop(), another task or core), without
+	locks, allocation or disabling interrupts. push() and pop() each finish
+	in a fixed number of steps, so neither side ever waits for the other.
+
+	Rules:
+	- exactly one producer calls push(), exactly one consumer calls pop()
+	- CAPACITY must be a power of two (2 to 128 on AVR, larger elsewhere)
+	- ELEMENT must be copyable with plain assignment (BMP180_Sample is)
+
+	Example:
+
+		BMP180_RingBuffer<BMP180_Sample, 16> samples;
+
+		producer:  BMP180_Sample s; if (pressure.getSample(s)) samples.push(s);
+		consumer:  BMP180_Sample s; while (samples.pop(s)) { ... }
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_RingBuffer_h
+#define BMP180_RingBuffer_h
+
+#include <stdint.h>
+
+// Each index is written by one side only and read by the other. The indices
+// run freely and are reduced modulo CAPACITY on use, so head - tail is the
+// fill level even after they wrap.
+
+#if defined(__AVR__)
+
+// Single core, and byte-sized loads and stores cannot be torn by an
+// interrupt; compiler barriers keep the element copy after the index load
+// and before the index store.
+typedef uint8_t BMP180_RingIndex;
+#define BMP180_RING_LOAD(x) __extension__ ({ BMP180_RingIndex _v = *(volatile BMP180_RingIndex *)&(x); __asm__ __volatile__("" ::: "memory"); _v; })
+#define BMP180_RING_STORE(x,v) do { __asm__ __volatile__("" ::: "memory"); *(volatile BMP180_RingIndex *)&(x) = (v); } while (0)
+
+#else
+
+// Acquire/release ordering makes the element copy visible to the other
+// side before the index that publishes it, also across cores.
+typedef uint32_t BMP180_RingIndex;
+#define BMP180_RING_LOAD(x) __atomic_load_n(&(x), __ATOMIC_ACQUIRE)
+#define BMP180_RING_STORE(x,v) __atomic_store_n(&(x), (v), __ATOMIC_RELEASE)
+
+#endif
+
+template <class ELEMENT, unsigned int CAPACITY>
+class BMP180_RingBuffer
+{
+	static_assert((CAPACITY >= 2) && ((CAPACITY & (CAPACITY - 1)) == 0), "CAPACITY must be a power of two");
+	static_assert(CAPACITY <= ((BMP180_RingIndex)-1 / 2) + 1, "CAPACITY too large for the index type");
+
+	public:
+		BMP180_RingBuffer() : head(0), tail(0) {}
+
+		char push(const ELEMENT &item)
+			// add an item (producer side only)
+			// returns 1 for success, 0 if the buffer is full (item dropped)
+		{
+			BMP180_RingIndex h = head; // only this side writes head
+			if ((BMP180_RingIndex)(h - BMP180_RING_LOAD(tail)) == CAPACITY)
+				return(0);
+			items[h & (CAPACITY - 1)] = item;
+			BMP180_RING_STORE(head, (BMP180_RingIndex)(h + 1));
+			return(1);
+		}
+
+		char pop(ELEMENT &item)
+			// remove the oldest item (consumer side only)
+			// returns 1 for success, 0 if the buffer is empty
+		{
+			BMP180_RingIndex t = tail; // only this side writes tail
+			if (BMP180_RING_LOAD(head) == t)
+				return(0);
+			item = items[t & (CAPACITY - 1)];
+			BMP180_RING_STORE(tail, (BMP180_RingIndex)(t + 1));
+			return(1);
+		}
+
+		unsigned int count(void)
+			// number of items waiting (exact from either side for its own view)
+		{
+			return((BMP180_RingIndex)(BMP180_RING_LOAD(head) - BMP180_RING_LOAD(tail)));
+		}
+
+		char empty(void)
+		{
+			return(count() == 0);
+		}
+
+		char full(void)
+		{
+			return(count() == CAPACITY);
+		}
+
+		unsigned int capacity(void)
+		{
+			return(CAPACITY);
+		}
+
+	private:
+		ELEMENT items[CAPACITY];
+		BMP180_RingIndex head; // next slot to fill; written by the producer
+		BMP180_RingIndex tail; // next slot to drain; written by the consumer
+};
+
+#endif
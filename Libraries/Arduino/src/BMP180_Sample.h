@@ -0,0 +1,29 @@
+/*
+	BMP180_Sample.h
+	One timestamped BMP180 reading, raw and compensated
+
+	Plain data with no Arduino dependencies, so it can be queued, logged
+	or sent to a host unchanged.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_Sample_h
+#define BMP180_Sample_h
+
+#include <stdint.h>
+
+struct BMP180_Sample
+{
+	uint32_t time; // micros() when the reading completed
+	double T; // temperature (deg C)
+	double P; // absolute pressure (mbar)
+	uint32_t UP; // raw 24-bit pressure reading (0xF6-0xF8)
+	uint16_t UT; // raw temperature word
+	uint8_t oss; // oversampling setting of the pressure reading
+	uint8_t status; // 0 for a good reading, otherwise the I2C error code (see SFE_BMP180::getError())
+};
+
+#endif
@@ -0,0 +1,188 @@
+/*
+	BMP180_Scheduler.h
+	Runs several BMP180s on separate I2C buses (Wire, Wire1, Wire2, ...) in parallel
+
+	Polling sensors one after another makes each one sit idle while the others
+	convert. The scheduler starts a measurement cycle on every sensor at
+	once and collects the results as each conversion finishes. A full snapshot
+	then takes about as long as one sensor's cycle, not N times as long.
+	Readings are collected apart from the last snapshot and published
+	together when every sensor has finished, so temperature(), pressure()
+	and isValid() always describe one snapshot, even in continuous mode.
+	A sensor whose begin() failed is left out of every snapshot.
+
+	Like BMP180_Driver it is a template on the bus class; the libraries
+	name it for theirs:
+
+		SFE_BMP180_Scheduler<N>       BMP180_Scheduler<TwoWire,N>
+		Teensy_BMP180_Scheduler<N>    BMP180_Scheduler<TwoWire,N>, or <i2c_t3,N> in utilyt
+
+	Example:
+
+		Teensy_BMP180 bmpA(&Wire), bmpB(&Wire1), bmpC(&Wire2);
+		Teensy_BMP180_Scheduler<3> sensors;
+
+		setup:  sensors.add(bmpA); sensors.add(bmpB); sensors.add(bmpC);
+		        sensors.begin(); sensors.start();
+		loop:   if (sensors.poll()) { use sensors.pressure(i) ...; sensors.start(); }
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_Scheduler_h
+#define BMP180_Scheduler_h
+
+#include <BMP180_Driver.h>
+
+template <class Bus, unsigned char N, class Real = BMP180_real>
+class BMP180_Scheduler
+{
+	public:
+		BMP180_Scheduler() : sensorCount(0), running(0), continuous(0), snapshotTime(0) {}
+
+		char add(BMP180_Driver<Bus,Real> &sensor)
+			// add a sensor (each one on its own bus)
+			// returns 1 for success, 0 if all N slots are taken
+		{
+			if (sensorCount >= N)
+				return(0);
+			sensors[sensorCount] = &sensor;
+			valid[sensorCount] = 0;
+			present[sensorCount] = 0;
+			sensorCount++;
+			return(1);
+		}
+
+		unsigned char begin(void)
+			// call begin() on every sensor that was added
+			// returns the number of sensors that began; the others are skipped from now on
+		{
+			unsigned char i, ready = 0;
+
+			for (i = 0; i < sensorCount; i++)
+			{
+				present[i] = sensors[i]->begin();
+				if (present[i])
+					ready++;
+			}
+			return(ready);
+		}
+
+		char isPresent(unsigned char i)
+			// returns 1 if sensor i began successfully
+		{
+			return((i < sensorCount) ? present[i] : 0);
+		}
+
+		void setContinuous(char enable)
+			// 1: poll() starts the next snapshot by itself as soon as one completes
+		{
+			continuous = enable;
+		}
+
+		char start(void)
+			// start a measurement cycle on every sensor at once
+			// returns the number of sensors that started (failed ones will be invalid)
+		{
+			unsigned char i, started = 0;
+
+			for (i = 0; i < sensorCount; i++)
+			{
+				pending[i] = present[i] ? sensors[i]->startCycle() : 0;
+				newValid[i] = 0;
+				if (pending[i])
+					started++;
+			}
+			running = (started != 0);
+			if (!running) // no snapshot will complete, so none of the last one stays valid
+			{
+				for (i = 0; i < sensorCount; i++)
+					valid[i] = 0;
+			}
+			return(started);
+		}
+
+		char poll(void)
+			// service every sensor's cycle without blocking; call often
+			// returns 1 when all sensors have finished and a new snapshot is ready
+		{
+			unsigned char i, busy = 0;
+			char result;
+
+			if (!running)
+				return(0);
+			for (i = 0; i < sensorCount; i++)
+			{
+				if (!pending[i])
+					continue;
+				result = sensors[i]->poll();
+				if (result == BMP180_POLL_READY)
+				{
+					newValid[i] = sensors[i]->getSample(newT[i], newP[i]);
+					pending[i] = 0;
+				}
+				else if (result == BMP180_POLL_ERROR)
+					pending[i] = 0;
+				else
+					busy = 1;
+			}
+			if (busy)
+				return(0);
+
+			// publish the whole snapshot at once
+			for (i = 0; i < sensorCount; i++)
+			{
+				T[i] = newT[i];
+				P[i] = newP[i];
+				valid[i] = newValid[i];
+			}
+			running = 0;
+			snapshotTime = micros();
+			if (continuous)
+				start();
+			return(1);
+		}
+
+		unsigned char count(void)
+			// returns the number of sensors added
+		{
+			return(sensorCount);
+		}
+
+		char isValid(unsigned char i)
+			// returns 1 if sensor i delivered a reading in the last snapshot
+		{
+			return((i < sensorCount) ? valid[i] : 0);
+		}
+
+		double temperature(unsigned char i)
+			// temperature of sensor i in the last snapshot (deg C)
+		{
+			return(T[i]);
+		}
+
+		double pressure(unsigned char i)
+			// absolute pressure of sensor i in the last snapshot (mbar)
+		{
+			return(P[i]);
+		}
+
+		unsigned long time(void)
+			// micros() when the last snapshot completed
+		{
+			return(snapshotTime);
+		}
+
+	private:
+		BMP180_Driver<Bus,Real> *sensors[N];
+		double T[N], P[N]; // last complete snapshot
+		double newT[N], newP[N]; // snapshot being collected
+		char valid[N], newValid[N], pending[N], present[N];
+		unsigned char sensorCount;
+		char running, continuous;
+		unsigned long snapshotTime;
+};
+
+#endif
@@ -0,0 +1,102 @@
+/*
+	BMP180_TelemetryFormat.h
+	Compact binary stream format for BMP180 samples over a serial link
+
+	The stream is a sequence of frames. A receiver that joins late, or
+	loses bytes, finds the next frame by its sync byte and keeps it only
+	if the CRC matches:
+
+	  sync      1 byte   BMP180_TELEMETRY_SYNC
+	  length    1 byte   payload bytes (1 to BMP180_TELEMETRY_MAX_PAYLOAD)
+	  payload   length bytes
+	  crc       2 bytes  BMP180_crc16() of length and payload, little-endian
+
+	The payload starts with a frame type and a sequence number (one more
+	than the previous frame's, modulo 256, so the receiver can count lost
+	frames). The rest depends on the type:
+
+	  BMP180_TELEMETRY_HEADER   version, time shift, mode, calibration (22 bytes)
+	  BMP180_TELEMETRY_RAW      oss, then samples of raw UT and UP
+	                            (bit 7 of oss set: UP is shifted right by 8 - oss,
+	                            dropping the bits below the ADC resolution)
+	  BMP180_TELEMETRY_FIXED    samples of T (0.01 deg C) and P (Pa)
+
+	Numbers are LEB128 varints (7 bits per byte, low bits first) and signed
+	ones are zigzag-coded first. The first sample of a frame carries
+	absolute values: time, UT or T, UP or P. Each later sample carries
+	the differences from the one before, so a steady reading costs about
+	three bytes. Times are micros() shifted right by the time shift.
+	Every frame decodes on its own (given the header, for raw samples).
+
+	Plain code with no Arduino dependencies, so host-side tools share it
+	(see extras/host).
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_TelemetryFormat_h
+#define BMP180_TelemetryFormat_h
+
+#include <stdint.h>
+#include <BMP180_Calibration.h>
+#include <BMP180_CRC.h>
+
+#define BMP180_TELEMETRY_SYNC 0xB1
+#define BMP180_TELEMETRY_VERSION 1
+#define BMP180_TELEMETRY_MAX_PAYLOAD 250
+#define BMP180_TELEMETRY_FRAME_BYTES 4 // sync, length and crc around the payload
+
+#define BMP180_TELEMETRY_HEADER 0x01 // frame types
+#define BMP180_TELEMETRY_RAW 0x02
+#define BMP180_TELEMETRY_FIXED 0x03
+
+#define BMP180_TELEMETRY_PACKED 0x80 // in the oss byte of a raw frame
+
+#define BMP180_TELEMETRY_HEADER_BYTES (2 + 3 + sizeof(BMP180_Calibration)) // header payload
+#define BMP180_TELEMETRY_MAX_RECORD 15 // one sample: three varints of up to 5 bytes
+
+inline uint8_t BMP180_putVarint(uint8_t *p, uint32_t value)
+	// store value at p as a varint
+	// returns the number of bytes used (1 to 5)
+{
+	uint8_t n = 0;
+
+	while (value >= 0x80)
+	{
+		p[n++] = (uint8_t)value | 0x80;
+		value >>= 7;
+	}
+	p[n++] = (uint8_t)value;
+	return(n);
+}
+
+inline uint8_t BMP180_getVarint(const uint8_t *p, const uint8_t *end, uint32_t &value)
+	// read a varint at p, not going past end
+	// returns the number of bytes used, 0 if the varint is cut off or too long
+{
+	uint8_t n = 0;
+
+	value = 0;
+	while (p + n < end && n < 5)
+	{
+		value |= (uint32_t)(p[n] & 0x7F) << (7 * n);
+		if (!(p[n++] & 0x80))
+			return(n);
+	}
+	return(0);
+}
+
+inline uint32_t BMP180_zigzag(int32_t value)
+	// map signed to unsigned so small magnitudes stay small (0, -1, 1, -2 ... to 0, 1, 2, 3 ...)
+{
+	return(((uint32_t)value << 1) ^ (uint32_t)(value >> 31));
+}
+
+inline int32_t BMP180_unzigzag(uint32_t value)
+{
+	return((int32_t)(value >> 1) ^ -(int32_t)(value & 1));
+}
+
+#endif
@@ -0,0 +1,211 @@
+/*
+	BMP180_TelemetryWriter.h
+	Binary telemetry encoder for BMP180 samples (see BMP180_TelemetryFormat.h)
+
+	Printing each reading as text costs 20 to 100 characters and a lot
+	of float formatting. This writer packs samples into CRC-checked
+	frames of varint deltas instead, 3 to 4 bytes per sample, so the same
+	UART carries five or more times the samples. extras/host has the
+	matching decoder (BMP180_TelemetryDecoder, bmp180decode).
+
+	Two modes:
+
+	  BMP180_TELEMETRY_RAW     raw UT/UP (smallest; the receiver compensates
+	                           them with the calibration sent in the header)
+	  BMP180_TELEMETRY_FIXED   T in 0.01 deg C and P in Pa (no calibration needed)
+
+	FRAME_BYTES is the payload size of a frame (32 to 250 bytes); the
+	frame is sent when it has no room for another sample. Larger frames
+	mean less framing overhead but more delay and more lost on a bad CRC.
+	64 bytes (about 15 samples, 80 bytes of RAM) is the default.
+
+	Example:
+
+		BMP180_TelemetryWriter<> telemetry(Serial);
+		BMP180_Calibration cal;
+		pressure.getCalibration(cal);
+		telemetry.begin(cal);
+		...
+		telemetry.append(pressure.measure(0));
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef BMP180_TelemetryWriter_h
+#define BMP180_TelemetryWriter_h
+
+#if defined(ARDUINO) && ARDUINO >= 100
+#include "Arduino.h"
+#else
+#include "WProgram.h"
+#endif
+
+#include <BMP180_TelemetryFormat.h>
+#include <BMP180_Sample.h>
+
+#define BMP180_TELEMETRY_HEADER_INTERVAL 64 // frames between repeated headers
+
+template <uint8_t FRAME_BYTES = 64>
+class BMP180_TelemetryWriter
+{
+	static_assert(FRAME_BYTES >= 32 && FRAME_BYTES <= BMP180_TELEMETRY_MAX_PAYLOAD, "FRAME_BYTES must be 32 to 250");
+
+	public:
+		BMP180_TelemetryWriter(Print &output) : out(output), mode(BMP180_TELEMETRY_RAW), packed(0), timeShift(10),
+			sequence(0), count(0), used(0), framesSinceHeader(0) {}
+
+		char begin(const BMP180_Calibration &cal, char mode = BMP180_TELEMETRY_RAW, uint8_t timeShift = 10)
+			// write the stream header (repeated every BMP180_TELEMETRY_HEADER_INTERVAL frames
+			// so a receiver that starts late can still compensate raw samples)
+			// cal: calibration words of the sensor (SFE_BMP180::getCalibration())
+			// mode: BMP180_TELEMETRY_RAW (default) or BMP180_TELEMETRY_FIXED
+			// timeShift: timestamps are micros() >> timeShift (default 10, about 1 ms; 0 to 16)
+			// returns 1 for success, 0 for a bad mode or time shift or if the write failed
+		{
+			if ((mode != BMP180_TELEMETRY_RAW && mode != BMP180_TELEMETRY_FIXED) || timeShift > 16)
+				return(0);
+			this->cal = cal;
+			this->mode = mode;
+			this->timeShift = timeShift;
+			count = 0;
+			used = 0;
+			return(writeHeader());
+		}
+
+		char append(const BMP180_Sample &sample)
+			// add one reading (from SFE_BMP180::measure() or getSample());
+			// writes the frame out when it fills, or first when the oversampling changes
+			// readings with a nonzero status are not sent
+			// returns 1 for success, 0 if a frame write failed
+		{
+			uint8_t *payload = &frame[2], *p;
+			uint32_t time, a, b;
+			uint8_t shift;
+			char ok = 1;
+
+			if (sample.status != 0)
+				return(1);
+
+			if (mode == BMP180_TELEMETRY_RAW)
+			{
+				// UP has 16 + oss significant bits; the ones below are normally zero
+				// and are dropped for as long as they stay that way
+
+				shift = 8 - (sample.oss & 3);
+				if (count > 0 && (sample.oss != oss || (packed && (sample.UP & ((1UL << shift) - 1)))))
+					ok = flush();
+				if (count == 0)
+					packed = !(sample.UP & ((1UL << shift) - 1));
+				a = sample.UT;
+				b = packed ? (sample.UP >> shift) : sample.UP;
+			}
+			else
+			{
+				a = (uint32_t)(int32_t)floor(sample.T * 100.0 + 0.5); // 0.01 deg C
+				b = (uint32_t)(int32_t)floor(sample.P * 100.0 + 0.5); // mbar to Pa
+			}
+			time = sample.time >> timeShift;
+
+			if (count == 0)
+			{
+				// First sample of a frame: absolute values
+
+				payload[0] = mode;
+				payload[1] = sequence;
+				used = 2;
+				if (mode == BMP180_TELEMETRY_RAW)
+				{
+					oss = sample.oss;
+					payload[used++] = packed ? (oss | BMP180_TELEMETRY_PACKED) : oss;
+				}
+				p = &payload[used];
+				p += BMP180_putVarint(p, time);
+				p += BMP180_putVarint(p, (mode == BMP180_TELEMETRY_RAW) ? a : BMP180_zigzag((int32_t)a));
+				p += BMP180_putVarint(p, b);
+			}
+			else
+			{
+				// Differences from the previous sample (modulo 2^32, so they also survive
+				// the micros() wrap)
+
+				p = &payload[used];
+				p += BMP180_putVarint(p, time - lastTime);
+				p += BMP180_putVarint(p, BMP180_zigzag((int32_t)(a - lastA)));
+				p += BMP180_putVarint(p, BMP180_zigzag((int32_t)(b - lastB)));
+			}
+			used = p - payload;
+			lastTime = time;
+			lastA = a;
+			lastB = b;
+			count++;
+			if (used + BMP180_TELEMETRY_MAX_RECORD > FRAME_BYTES)
+				ok = flush() && ok;
+			return(ok);
+		}
+
+		char flush(void)
+			// write out a partly filled frame (for instance before a pause in sampling)
+			// returns 1 for success (or nothing to write), 0 if the write failed
+		{
+			char ok;
+
+			if (count == 0)
+				return(1);
+			count = 0;
+			ok = writeFrame();
+			if (++framesSinceHeader >= BMP180_TELEMETRY_HEADER_INTERVAL)
+				ok = writeHeader() && ok;
+			return(ok);
+		}
+
+		uint8_t pending(void)
+			// returns the number of samples waiting in the current frame
+		{
+			return(count);
+		}
+
+	private:
+
+		char writeHeader(void)
+		{
+			uint8_t *p = &frame[2];
+
+			*p++ = BMP180_TELEMETRY_HEADER;
+			*p++ = sequence;
+			*p++ = BMP180_TELEMETRY_VERSION;
+			*p++ = timeShift;
+			*p++ = mode;
+			memcpy(p, &cal, sizeof(cal));
+			used = BMP180_TELEMETRY_HEADER_BYTES;
+			framesSinceHeader = 0;
+			return(writeFrame());
+		}
+
+		char writeFrame(void)
+			// frame the used bytes of payload and write them in one call
+		{
+			uint16_t crc;
+			size_t length;
+
+			frame[0] = BMP180_TELEMETRY_SYNC;
+			frame[1] = used;
+			crc = BMP180_crc16(&frame[1], used + 1);
+			frame[used + 2] = (uint8_t)crc;
+			frame[used + 3] = (uint8_t)(crc >> 8);
+			length = used + BMP180_TELEMETRY_FRAME_BYTES;
+			used = 0;
+			sequence++;
+			return(out.write(frame, length) == length);
+		}
+
+		Print &out;
+		BMP180_Calibration cal;
+		char mode, packed;
+		uint8_t timeShift, sequence, oss, count, used, framesSinceHeader;
+		uint32_t lastTime, lastA, lastB;
+		uint8_t frame[2 + FRAME_BYTES + 2]; // sync, length, payload, crc
+};
+
+#endif
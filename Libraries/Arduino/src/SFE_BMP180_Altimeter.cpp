@@ -0,0 +1,99 @@
+/*
+	SFE_BMP180_Altimeter.cpp
+	Fast pressure-to-altitude conversion for the SFE_BMP180 library
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <SFE_BMP180_Altimeter.h>
+#include <math.h>
+
+
+SFE_BMP180_Altimeter::SFE_BMP180_Altimeter()
+{
+	setBaseline(1013.25);
+	seaA = 0.0;
+	seaFactor = 1.0;
+}
+
+
+void SFE_BMP180_Altimeter::setBaseline(double P0)
+// Tabulate the barometric formula for a new baseline pressure.
+// Altitude is 44330 - g(P), with g(P) = 44330 * (P/P0)^(1/5.255).
+// The slope of g is g/(5.255 P), so each table entry also gets the exact
+// slope needed for cubic Hermite interpolation.
+{
+	unsigned char i;
+	double Pi;
+
+	baseline = P0;
+	for (i = 0; i < BMP180_ALTIMETER_POINTS; i++)
+	{
+		Pi = BMP180_ALTIMETER_PMIN + (i * BMP180_ALTIMETER_STEP);
+		g[i] = 44330.0 * pow(Pi/P0,1/5.255);
+		m[i] = g[i] * BMP180_ALTIMETER_STEP / (5.255 * Pi);
+	}
+}
+
+
+double SFE_BMP180_Altimeter::getBaseline(void)
+{
+	return(baseline);
+}
+
+
+double SFE_BMP180_Altimeter::altitude(double P)
+// Given a pressure measurement P (mb), return altitude (meters) above the baseline.
+{
+	double u, t, d;
+	unsigned char i;
+
+	if ((P < BMP180_ALTIMETER_PMIN) || (P > BMP180_ALTIMETER_PMAX))
+		return(exactAltitude(P));
+
+	// Find the table segment and the position t (0 to 1) within it:
+
+	u = (P - BMP180_ALTIMETER_PMIN) * (1.0 / BMP180_ALTIMETER_STEP);
+	i = (unsigned char)u;
+	if (i > BMP180_ALTIMETER_POINTS - 2)
+		i = BMP180_ALTIMETER_POINTS - 2; // P == PMAX lands at the end of the last segment
+	t = u - i;
+
+	// Cubic Hermite between g[i] and g[i+1] (Horner form):
+
+	d = g[i+1] - g[i];
+	return(44330.0 - (g[i] + t * (m[i] + t * ((3.0 * d - 2.0 * m[i] - m[i+1]) + t * (m[i] + m[i+1] - 2.0 * d)))));
+}
+
+
+void SFE_BMP180_Altimeter::altitude(const double *P, double *A, unsigned int count)
+// Convert count pressures (mb) to altitudes (meters) above the baseline.
+{
+	unsigned int n;
+
+	for (n = 0; n < count; n++)
+		A[n] = altitude(P[n]);
+}
+
+
+double SFE_BMP180_Altimeter::sealevel(double P, double A)
+// Given a pressure P (mb) taken at a specific altitude (meters),
+// return the equivalent pressure (mb) at sea level.
+// The correction factor is only recomputed when A changes.
+{
+	if (A != seaA)
+	{
+		seaA = A;
+		seaFactor = 1.0 / pow(1-(A/44330.0),5.255);
+	}
+	return(P * seaFactor);
+}
+
+
+double SFE_BMP180_Altimeter::exactAltitude(double P)
+// Same formula as SFE_BMP180::altitude()
+{
+	return(44330.0*(1-pow(P/baseline,1/5.255)));
+}
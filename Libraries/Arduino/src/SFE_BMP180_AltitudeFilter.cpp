@@ -0,0 +1,273 @@
+/*
+	SFE_BMP180_AltitudeFilter.cpp
+	Altitude and vertical speed estimator for the SFE_BMP180 library
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#include <SFE_BMP180_AltitudeFilter.h>
+#include <math.h>
+
+#ifdef BMP180_ALTITUDE_FIXED
+#define BMP180_ALTITUDE_ONE 65536.0 // 1.0 in 16.16 fixed point
+#define BMP180_ALTITUDE_GAIN_ONE 16777216.0 // 1.0 in 0.24 fixed point
+#define BMP180_ALTITUDE_STATE_ONE 1099511627776.0 // 1.0 in 24.40 fixed point (2^40)
+#define BMP180_ALTITUDE_LIMIT 30000.0 // meters, keeps altitudes inside 16.16 range
+#define BMP180_ALTITUDE_PMIN 480000L // BMP180_ALTIMETER_PMIN in 1/16 Pa
+#define BMP180_ALTITUDE_STEP 80000L // BMP180_ALTIMETER_STEP in 1/16 Pa
+#define BMP180_ALTITUDE_STEP_INVERSE 53687UL // 65536 * 65536 / BMP180_ALTITUDE_STEP
+
+
+static int32_t mulFixed(int32_t v, int32_t f)
+// Returns v * f / 65536, rounded to nearest: the same result as a 64-bit
+// product, from three 32-bit multiplies (much cheaper on AVR).
+// v: 16.16 fixed point; f: 0.16 fixed point, 0 to 131071 (0 to 2.0)
+{
+	int32_t high = v >> 16;
+	uint16_t low = (uint16_t)v;
+	uint16_t fraction = (uint16_t)f;
+
+	return((v * (f >> 16)) + (high * (int32_t)fraction) + (int32_t)((((uint32_t)low * fraction) + 0x8000) >> 16));
+}
+#endif
+
+
+SFE_BMP180_AltitudeFilter::SFE_BMP180_AltitudeFilter()
+{
+	altitudeNoise = 0.5;
+	accelNoise = 1.0;
+	begin(1013.25,0.1);
+}
+
+
+void SFE_BMP180_AltitudeFilter::begin(double P0, double interval)
+// Set the baseline and sample interval, recompute the gains and start over.
+// P0: baseline pressure (mbar)
+// interval: seconds between samples
+{
+#ifdef BMP180_ALTITUDE_FIXED
+	unsigned char i;
+	double Pi, g;
+
+	// The same table as SFE_BMP180_Altimeter, as altitudes rather than 44330 - altitude
+
+	baseline = P0;
+	for (i = 0; i < BMP180_ALTIMETER_POINTS; i++)
+	{
+		Pi = BMP180_ALTIMETER_PMIN + (i * BMP180_ALTIMETER_STEP);
+		g = 44330.0 * pow(Pi/P0,1/5.255);
+		altitudes[i] = (int32_t)floor(((44330.0 - g) * BMP180_ALTITUDE_ONE) + 0.5);
+		slopes[i] = (int32_t)floor((-g * BMP180_ALTIMETER_STEP / (5.255 * Pi) * BMP180_ALTITUDE_ONE) + 0.5);
+	}
+#else
+	altimeter.setBaseline(P0);
+#endif
+	this->interval = interval;
+	computeGains();
+	reset();
+}
+
+
+void SFE_BMP180_AltitudeFilter::setNoise(double altitudeNoise, double accelNoise)
+// Change the noise levels the gains are tuned for. The state is kept.
+// altitudeNoise: standard deviation of one altitude reading (meters)
+// accelNoise: standard deviation of the vertical acceleration (m/s/s)
+{
+	this->altitudeNoise = altitudeNoise;
+	this->accelNoise = accelNoise;
+	computeGains();
+}
+
+
+void SFE_BMP180_AltitudeFilter::computeGains(void)
+// Steady-state Kalman gains for a constant-velocity model driven by random
+// acceleration (Kalata, "The Tracking Index", IEEE AES-20, 1984).
+// The tracking index is the ratio of motion uncertainty to measurement
+// noise over one sample: lambda = accelNoise * interval^2 / altitudeNoise.
+{
+	double lambda, r, a, b;
+
+	if (altitudeNoise <= 0.0)
+		lambda = 1e6; // perfect measurements: follow them exactly
+	else
+		lambda = accelNoise * interval * interval / altitudeNoise;
+	r = (4.0 + lambda - sqrt((8.0 * lambda) + (lambda * lambda))) / 4.0;
+	a = 1.0 - (r * r);
+	b = (2.0 * (2.0 - a)) - (4.0 * sqrt(1.0 - a));
+
+#ifdef BMP180_ALTITUDE_FIXED
+	alpha = (int32_t)((a * BMP180_ALTITUDE_GAIN_ONE) + 0.5);
+	beta = (int32_t)((b * BMP180_ALTITUDE_GAIN_ONE) + 0.5);
+#else
+	alpha = a;
+	beta = b;
+#endif
+}
+
+
+void SFE_BMP180_AltitudeFilter::reset(void)
+// Forget the state; the next sample starts the filter.
+{
+	h = 0;
+	d = 0;
+	primed = 0;
+}
+
+
+void SFE_BMP180_AltitudeFilter::update(double P)
+// Add one pressure sample.
+// P: absolute pressure (mbar)
+{
+#ifdef BMP180_ALTITUDE_FIXED
+	int32_t A;
+
+	if (fixedAltitude((int32_t)((P * 1600.0) + 0.5), A))
+		updateFixed(A);
+	else
+		updateAltitude(44330.0*(1-pow(P/baseline,1/5.255)));
+#else
+	updateAltitude(altimeter.altitude(P));
+#endif
+}
+
+
+void SFE_BMP180_AltitudeFilter::updatePressureInt(int32_t P)
+// Add one pressure sample in integer form.
+// P: absolute pressure (Pa)
+{
+#ifdef BMP180_ALTITUDE_FIXED
+	int32_t A;
+
+	if (fixedAltitude(P * 16, A))
+		updateFixed(A);
+	else
+		updateAltitude(44330.0*(1-pow(P/(100.0*baseline),1/5.255)));
+#else
+	update(P / 100.0);
+#endif
+}
+
+
+void SFE_BMP180_AltitudeFilter::updateAltitude(double A)
+// Add one altitude sample: predict one interval ahead, then correct
+// altitude and climb rate by the gains times the prediction error.
+// The climb rate is kept as change per sample (d), which keeps the
+// interval out of the per-sample arithmetic.
+// A: altitude relative to the baseline (meters)
+{
+#ifdef BMP180_ALTITUDE_FIXED
+	if (A > BMP180_ALTITUDE_LIMIT)
+		A = BMP180_ALTITUDE_LIMIT;
+	else if (A < -BMP180_ALTITUDE_LIMIT)
+		A = -BMP180_ALTITUDE_LIMIT;
+	updateFixed((int32_t)(A * BMP180_ALTITUDE_ONE));
+#else
+	double r;
+
+	if (!primed)
+	{
+		h = A;
+		d = 0.0;
+		primed = 1;
+		return;
+	}
+
+	h += d;
+	r = A - h;
+	h += alpha * r;
+	d += beta * r;
+#endif
+}
+
+
+#ifdef BMP180_ALTITUDE_FIXED
+char SFE_BMP180_AltitudeFilter::fixedAltitude(int32_t P, int32_t &A)
+// SFE_BMP180_Altimeter::altitude() in fixed point: cubic Hermite between
+// the two table entries around P.
+// P: absolute pressure (1/16 Pa)
+// A: altitude relative to the baseline (meters, 16.16)
+{
+	int32_t u, t, dA, c2, c3;
+	unsigned char i;
+
+	u = P - BMP180_ALTITUDE_PMIN;
+	if ((u < 0) || (u > BMP180_ALTITUDE_STEP * (BMP180_ALTIMETER_POINTS - 1)))
+		return(0);
+
+	// Find the table segment (subtracting beats a 32-bit divide on AVR)
+	// and the position t within it (0.16 fixed point):
+
+	for (i = 0; (u >= BMP180_ALTITUDE_STEP) && (i < BMP180_ALTIMETER_POINTS - 2); i++)
+		u -= BMP180_ALTITUDE_STEP;
+	t = (int32_t)(((uint32_t)u * BMP180_ALTITUDE_STEP_INVERSE) >> 16);
+	if (t > 0xFFFF)
+		t = 0xFFFF; // P == PMAX lands at the end of the last segment
+
+	dA = altitudes[i+1] - altitudes[i];
+	c2 = (3 * dA) - (2 * slopes[i]) - slopes[i+1];
+	c3 = slopes[i] + slopes[i+1] - (2 * dA);
+	A = altitudes[i] + mulFixed(slopes[i] + mulFixed(c2 + mulFixed(c3, t), t), t);
+	return(1);
+}
+
+
+void SFE_BMP180_AltitudeFilter::updateFixed(int32_t A)
+// The filter step of updateAltitude() in fixed point.
+// The error r is 16.16 and the gains 0.24, so their products are exact
+// in the 24.40 state: nothing is rounded from one sample to the next.
+// A: altitude relative to the baseline (meters, 16.16)
+{
+	int64_t e;
+	int32_t r;
+
+	if (!primed)
+	{
+		h = (int64_t)A << 24;
+		d = 0;
+		primed = 1;
+		return;
+	}
+
+	h += d;
+	e = (int64_t)A - ((h + 0x800000) >> 24); // may exceed 16.16 when h is far from A
+	if (e > 0x7FFFFFFFL)
+		r = 0x7FFFFFFFL;
+	else if (e < -0x7FFFFFFFL)
+		r = -0x7FFFFFFFL;
+	else
+		r = (int32_t)e;
+	h += (int64_t)r * alpha;
+	d += (int64_t)r * beta;
+}
+#endif
+
+
+double SFE_BMP180_AltitudeFilter::getAltitude(void)
+// Returns the filtered altitude above the baseline (meters).
+{
+#ifdef BMP180_ALTITUDE_FIXED
+	return(h / BMP180_ALTITUDE_STATE_ONE);
+#else
+	return(h);
+#endif
+}
+
+
+double SFE_BMP180_AltitudeFilter::getVelocity(void)
+// Returns the filtered climb rate (meters per second, positive = up).
+{
+#ifdef BMP180_ALTITUDE_FIXED
+	return(d / BMP180_ALTITUDE_STATE_ONE / interval);
+#else
+	return(d / interval);
+#endif
+}
+
+
+char SFE_BMP180_AltitudeFilter::ready(void)
+// Returns 1 once a sample has been added since reset().
+{
+	return(primed);
+}
@@ -0,0 +1,117 @@
+/*
+	SFE_BMP180_AltitudeFilter.h
+	Altitude and vertical speed estimator for the SFE_BMP180 library
+
+	Turns a steady stream of pressure samples into a smoothed altitude and a
+	climb rate. It is the steady-state Kalman filter for a constant-velocity
+	model (an alpha-beta filter with Kalata's optimal gains): the gains are
+	worked out once in begin() / setNoise(), so each update is only a few
+	multiplies and adds.
+
+	Pressure is converted with SFE_BMP180_Altimeter, the pow()-free version
+	of SFE_BMP180::altitude(P, P0), so altitudes are relative to the
+	baseline pressure P0.
+
+	On processors without an FPU (AVR, Cortex-M0) the filter runs in fixed
+	point: altitudes come in as 16.16 (meters; range +/-30000 m,
+	resolution 15 um), and the pressure-to-altitude table is evaluated
+	with 32-bit integer multiplies only. The state and the gains carry 24
+	more fraction bits (64-bit state, 0.24 gains), because at short
+	intervals the climb rate gain is only about 1e-4 and rounding it or
+	its corrections to 16 bits would bias the climb rate by percent.
+	updatePressureInt() with the Pa from SFE_BMP180::getPressureInt()
+	then runs without any floating point; update() costs one float
+	multiply to get there. Pressures outside 300-1100 mbar fall back to
+	the floating-point formula. Elsewhere the filter uses floating point.
+	Define BMP180_ALTITUDE_FLOAT or BMP180_ALTITUDE_FIXED before including
+	this file to choose (extras/host, make altitude, compares the two).
+
+	The filter assumes samples arrive at a fixed interval, as they do from
+	startCycle() / poll() or a timer. Feed every sample; skipping samples
+	without calling reset() makes the climb rate wrong until it settles.
+
+	Our example code uses the "beerware" license. You can do anything
+	you like with this code. No really, anything. If you find it useful,
+	buy me a (root) beer someday.
+*/
+
+#ifndef SFE_BMP180_AltitudeFilter_h
+#define SFE_BMP180_AltitudeFilter_h
+
+#include <stdint.h>
+#include <SFE_BMP180_Altimeter.h>
+
+#if !defined(BMP180_ALTITUDE_FLOAT) && !defined(BMP180_ALTITUDE_FIXED) && (defined(__AVR__) || (defined(__arm__) && !defined(__ARM_FP)))
+#define BMP180_ALTITUDE_FIXED
+#endif
+
+class SFE_BMP180_AltitudeFilter
+{
+	public:
+		SFE_BMP180_AltitudeFilter();
+			// baseline 1013.25 mbar, 10 samples per second, default noise levels
+
+		void begin(double P0, double interval);
+			// set up the filter and forget any previous samples
+			// P0: baseline pressure (mbar); altitude 0 is where the pressure equals P0
+			// interval: time between samples (seconds), e.g. 0.0075 for back-to-back OSS 0 cycles
+
+		void setNoise(double altitudeNoise, double accelNoise);
+			// tune the filter (default 0.5 m and 1.0 m/s/s)
+			// altitudeNoise: standard deviation of one altitude reading (meters)
+			//   about 0.5 m at OSS 0, 0.25 m at OSS 3
+			// accelNoise: typical vertical acceleration of the platform (m/s/s)
+			//   smaller = smoother but slower to follow real climbs and descents
+
+		void reset(void);
+			// forget the filter state; the next sample sets altitude directly, with zero climb rate
+
+		void update(double P);
+			// add one pressure sample
+			// P: absolute pressure (mbar)
+
+		void updatePressureInt(int32_t P);
+			// add one pressure sample from SFE_BMP180::getPressureInt()
+			// P: absolute pressure (Pa)
+
+		void updateAltitude(double A);
+			// add one altitude sample directly
+			// A: altitude relative to the baseline (meters)
+
+		double getAltitude(void);
+			// returns the filtered altitude (meters above baseline)
+
+		double getVelocity(void);
+			// returns the filtered climb rate (meters per second, positive = up)
+
+		char ready(void);
+			// returns 1 once at least one sample has been added since reset()
+
+	private:
+
+		void computeGains(void);
+			// steady-state gains from interval and the noise levels
+
+		double interval, altitudeNoise, accelNoise;
+		char primed;
+#ifdef BMP180_ALTITUDE_FIXED
+		char fixedAltitude(int32_t P, int32_t &A);
+			// table lookup in fixed point; P in 1/16 Pa, A in meters (16.16)
+			// returns 1 for success, 0 if P is outside the table
+
+		void updateFixed(int32_t A);
+			// filter step for an altitude in meters (16.16)
+
+		double baseline; // P0 (mbar), for pressures outside the table
+		int32_t altitudes[BMP180_ALTIMETER_POINTS]; // altitude at each table pressure (meters, 16.16)
+		int32_t slopes[BMP180_ALTIMETER_POINTS]; // its slope times the table step (meters, 16.16)
+		int64_t h, d; // altitude, and its change per sample (meters, 24.40 fixed point)
+		int32_t alpha, beta; // gains (0.24 fixed point, up to 2.0)
+#else
+		SFE_BMP180_Altimeter altimeter;
+		double h, d; // altitude, and its change per sample (meters)
+		double alpha, beta; // gains
+#endif
+};
+
+#endif
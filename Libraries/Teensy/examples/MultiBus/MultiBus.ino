@@ -0,0 +1,47 @@
+/*
+ *  Three BMP180s, one per I2C bus, read in parallel.
+ *
+ *  BMP180    Teensy 3.5
+ *
+ *  Wire:  SDA 18, SCL 19
+ *  Wire1: SDA 38, SCL 37
+ *  Wire2: SDA 4,  SCL 3
+ *
+ *  The scheduler starts every sensor's conversion at once, so a snapshot
+ *  of all three takes about as long as reading a single sensor.
+ */
+#include <Teensy_BMP180.h>
+
+Teensy_BMP180 bmpA(&Wire);
+Teensy_BMP180 bmpB(&Wire1);
+Teensy_BMP180 bmpC(&Wire2);
+Teensy_BMP180_Scheduler<3> sensors;
+
+void setup() {
+  Serial.begin(9600);
+  sensors.add(bmpA);
+  sensors.add(bmpB);
+  sensors.add(bmpC);
+  if (sensors.begin() < sensors.count()) {
+    Serial.println("a BMP180 did not respond, it will read as error");
+  }
+  sensors.setContinuous(1);
+  sensors.start();
+}
+
+void loop() {
+  // poll() never blocks, so there is time for other work here
+  if (sensors.poll()) {
+    for (unsigned char i = 0; i < sensors.count(); i++) {
+      if (sensors.isValid(i)) {
+        Serial.print(sensors.temperature(i));
+        Serial.print(" C ");
+        Serial.print(sensors.pressure(i));
+        Serial.print(" mb | ");
+      } else {
+        Serial.print("error | ");
+      }
+    }
+    Serial.println();
+  }
+}
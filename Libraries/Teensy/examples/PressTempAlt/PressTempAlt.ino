@@ -49,12 +49,19 @@ void loop() {
 
 boolean getPressure()
 {
-  if (bmp180.startTemperature() != 0)
+  char status;
+
+  //start*() returns the conversion time in ms; wait that long before reading
+  status = bmp180.startTemperature();
+  if (status != 0)
   {
+    delay(status);
     if (bmp180.getTemperature(bmpValues[0]) != 0)
     {
-      if (bmp180.startPressure() != 0)
+      status = bmp180.startPressure();
+      if (status != 0)
       {
+        delay(status);
         if (bmp180.getPressure(bmpValues[1],bmpValues[0]) != 0)
         {
           return(1);
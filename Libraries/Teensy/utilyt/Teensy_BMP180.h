@@ -5,90 +5,58 @@
 	unalfaruk.com / A.Faruk UNAL / ahmet@unalfaruk.com || unalfaruk@outlook.com
 	This library depends on SparkFUN BMP180 library and https://roboticboat.uk/Teensy/Teensy36/BMP180.html page.
 
+	The driver itself is BMP180_Driver.h from the SparkFun BMP180 library,
+	used here on the i2c_t3 bus class. Functions, return values and error
+	codes are documented there.
+
+	getTemperature() and getPressure() keep the behaviour of earlier
+	versions of this library: they wait for the conversion started by
+	startTemperature() / startPressure() to finish before reading it, so
+	sketches that call them straight after starting still get a finished
+	result. Sketches that wait themselves lose nothing, since the wait
+	ends as soon as the conversion is ready.
 	---
 */
 
 #ifndef Teensy_BMP180_h
 #define Teensy_BMP180_h
-
 #include "i2c_t3.h"
+#include <BMP180_Driver.h>
+#include <BMP180_Scheduler.h>
 
-class Teensy_BMP180
+class Teensy_BMP180 : public BMP180_Driver<i2c_t3>
 {
 	public:
 
-		Teensy_BMP180(i2c_t3 *hwWire){
-			WireSelected=hwWire;
-		} // base type
-
-		void begin();
-			// call pressure.begin() to initialize BMP180 before use
-			// returns 1 if success, 0 if failure (bad component or I2C bus shorted?)
-
-		char startTemperature(void);
-			// command BMP180 to start a temperature measurement
-			// returns (number of ms to wait) for success, 0 for fail
-
-		char getTemperature(double &T);
-			// return temperature measurement from previous startTemperature command
-			// places returned value in T variable (deg C)
-			// returns 1 for success, 0 for fail
-
-		char startPressure(void);
-			// command BMP180 to start a pressure measurement
-			// oversampling: 0 - 3 for oversampling value
-			// returns (number of ms to wait) for success, 0 for fail
-
-		char getPressure(double &P, double &T);
-			// return absolute pressure measurement from previous startPressure command
-			// note: requires previous temperature measurement in variable T
-			// places returned value in P variable (mbar)
-			// returns 1 for success, 0 for fail
-
-		double altitude(double P, double P0);
-			// convert absolute pressure to altitude (given baseline pressure; sea-level, runway, etc.)
-			// P: absolute pressure (mbar)
-			// P0: fixed baseline pressure (mbar)
-			// returns signed altitude in meters
+		Teensy_BMP180(i2c_t3 *hwWire) : BMP180_Driver<i2c_t3>(hwWire) {} // base type
 
+		char getTemperature(double &T){
+			// wait for the conversion from startTemperature(), then read it (see BMP180_Driver.h)
+			while (!conversionReady()) {yield();}
+			return(BMP180_Driver<i2c_t3>::getTemperature(T));
+		}
 
+		char getPressure(double &P, double &T){
+			// wait for the conversion from startPressure(), then read it (see BMP180_Driver.h)
+			while (!conversionReady()) {yield();}
+			return(BMP180_Driver<i2c_t3>::getPressure(P, T));
+		}
+};
 
-	private:
-
-		char readInt(char address, int16_t &value);
-			// read an signed int (16 bits) from a BMP180 register
-			// address: BMP180 register address
-			// value: external signed int for returned value (16 bits)
-			// returns 1 for success, 0 for fail, with result in value
-
-		char readUInt(char address, uint16_t &value);
-			// read an unsigned int (16 bits) from a BMP180 register
-			// address: BMP180 register address
-			// value: external unsigned int for returned value (16 bits)
-			// returns 1 for success, 0 for fail, with result in value
-
-
-		int16_t AC1,AC2,AC3,VB1,VB2,MB,MC,MD;
-		uint16_t AC4,AC5,AC6;
-
-		double c5,c6,mc,md;
-		double xx0,xx1,xx2;
-		double yy0,yy1,yy2;
-		double p0,p1,p2;
+template <unsigned char N> using Teensy_BMP180_Scheduler = BMP180_Scheduler<i2c_t3,N>; // several buses in parallel, see BMP180_Scheduler.h
 
-		i2c_t3 *WireSelected;
-};
+//Names from version 1 of this library, kept for sketches that use them
 
 //Address of the BMP180 address
-#define _i2cAddress 0x77
+#define _i2cAddress BMP180_ADDR
 
 //Registers
-#define _Register_CONTROL 0xF4
-#define _Register_RESULT 0xF6
+#define _Register_CONTROL BMP180_REG_CONTROL
+#define _Register_RESULT BMP180_REG_RESULT
 
 //Commands
-#define _COMMAND_TEMPERATURE 0x2E
-#define _COMMAND_PRESSURE 0xF4
+#define _COMMAND_TEMPERATURE BMP180_COMMAND_TEMPERATURE
+#define _COMMAND_PRESSURE BMP180_COMMAND_PRESSURE3 // oversampling 3, as before
 
 #define _ONE_BYTE 1
 #define _TWO_BYTES 2